@@ -129,6 +129,7 @@ bool PortfolioMode::perform(Problem* problem)
 #if VTIME_PROFILING
     if (env.options && env.options->timeStatistics()) {
       TimeTrace::instance().printPretty(cout);
+      TimeTrace::instance().exportToFile();
     }
 #endif // VTIME_PROFILING
   }
@@ -432,6 +433,32 @@ void PortfolioMode::getSchedules(const Property& prop, Schedule& quick, Schedule
   }
 }
 
+#if VTIME_PROFILING
+/** The file in which the slice run by process @b child of @b parent leaves its time trace */
+static fs::path timeTracePath(pid_t parent, pid_t child)
+{
+  return fs::temp_directory_path() / ("vampire-time-trace-" + Int::toString(parent) + "-" + Int::toString(child));
+}
+
+/** Merge the time trace of the slice run by @b child into ours */
+static void collectTimeTrace(pid_t child)
+{
+  if (!env.options->timeStatistics()) {
+    return;
+  }
+  fs::path path = timeTracePath(getpid(), child);
+  {
+    std::ifstream input(path);
+    if (input.fail()) {
+      return;
+    }
+    TimeTrace::instance().merge(input);
+  }
+  std::error_code ignored;
+  fs::remove(path, ignored);
+}
+#endif // VTIME_PROFILING
+
 bool PortfolioMode::runSchedule(Schedule schedule) {
   TIME_TRACE("run schedule");
 
@@ -481,6 +508,9 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
     if(exited)
     {
       ALWAYS(processes.remove(process));
+#if VTIME_PROFILING
+      collectTimeTrace(process);
+#endif
       if(!code)
       {
         success = true;
@@ -496,8 +526,17 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
 
   // kill all running processes first
   decltype(processes)::Iterator killIt(processes);
-  while(killIt.hasNext())
-    Multiprocessing::instance()->killNoCheck(killIt.next(), SIGINT);
+  while(killIt.hasNext()) {
+    pid_t process = killIt.next();
+    Multiprocessing::instance()->killNoCheck(process, SIGINT);
+#if VTIME_PROFILING
+    if (env.options->timeStatistics()) {
+      // the slice may have finished and left its time trace
+      std::error_code ignored;
+      fs::remove(timeTracePath(getpid(), process), ignored);
+    }
+#endif
+  }
 
   return success;
 }
@@ -653,6 +692,14 @@ void PortfolioMode::runSlice(Options& strategyOpt)
 
   Saturation::ProvingHelper::runVampire(*_prb, opt);
 
+#if VTIME_PROFILING
+  if (env.options->timeStatistics()) {
+    // for the parent to merge into its time trace
+    std::ofstream output(timeTracePath(getppid(), getpid()));
+    TimeTrace::instance().serialize(output);
+  }
+#endif
+
   bool succeeded =
     env.statistics->terminationReason == Statistics::REFUTATION ||
     env.statistics->terminationReason == Statistics::SATISFIABLE;
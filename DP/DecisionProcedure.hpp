@@ -60,6 +60,16 @@ public:
   virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex=0) = 0;
   /** reset decision procedure object into state equivalent to its initial state */
   virtual void reset() = 0;
+
+  /**
+   * If true, push and pop can be used instead of reset to retract
+   * only the literals added since some point.
+   */
+  virtual bool supportsBacktracking() const { return false; }
+  /** open a new backtracking level, literals added from now on are retracted by the matching pop */
+  virtual void push() { NOT_IMPLEMENTED; }
+  /** retract the literals added since the @c levelCnt most recent calls to push */
+  virtual void pop(unsigned levelCnt = 1) { NOT_IMPLEMENTED; }
 };
 
 }
@@ -49,6 +49,13 @@ public:
     _unsatCores.reset();
   }
 
+  bool supportsBacktracking() const override { return _inner->supportsBacktracking(); }
+  void push() override { _inner->push(); }
+  void pop(unsigned levelCnt) override {
+    _inner->pop(levelCnt);
+    _unsatCores.reset();
+  }
+
   virtual Status getStatus(bool getMultipleCores) override;
 
   void getModel(LiteralStack& model) override {
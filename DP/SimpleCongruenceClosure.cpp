@@ -142,8 +142,6 @@ SimpleCongruenceClosure::SimpleCongruenceClosure(Ordering* ord) :
   _posLitConst = getFreshConst();
   _negLitConst = getFreshConst();
   _negEqualities.push(CEq(_posLitConst, _negLitConst, 0));
-
-  _hadPropagated = false;
 }
 
 void SimpleCongruenceClosure::reset()
@@ -154,15 +152,13 @@ void SimpleCongruenceClosure::reset()
     _cInfos[i].resetEquivalences(*this, i);
   }
 
-  PairMap::DelIterator pmit(_pairNames);
+  _lookup.reset();
+  PairMap::Iterator pmit(_pairNames);
   while(pmit.hasNext()) {
     CPair namePair;
     unsigned nameConst;
     pmit.next(namePair, nameConst);
-
-    if(_cInfos[nameConst].namedPair!=namePair) {
-      pmit.del();
-    }
+    _lookup.insert(namePair, nameConst);
   }
 
   //this leaves us just with the true!=false non-equality
@@ -177,7 +173,104 @@ void SimpleCongruenceClosure::reset()
   _distinctConstraints.reset();
   _negDistinctConstraints.reset();
 
-  _hadPropagated = false;
+  _trail.reset();
+  _levels.reset();
+}
+
+/**
+ * Open a new backtracking level. The pending equalities are propagated first,
+ * so that they stay when the level is popped.
+ */
+void SimpleCongruenceClosure::push()
+{
+  propagate();
+
+  Level lvl;
+  lvl.trailSize = _trail.size();
+  lvl.constCnt = _cInfos.size();
+  lvl.negEqualityCnt = _negEqualities.size();
+  lvl.distinctCnt = _distinctConstraints.size();
+  lvl.negDistinctCnt = _negDistinctConstraints.size();
+  _levels.push(lvl);
+}
+
+/**
+ * Return to the state before the @c levelCnt most recent calls to push.
+ *
+ * The constants introduced meanwhile are kept together with their names,
+ * as they are on reset, but their use in the classes of the restored state
+ * is registered again.
+ */
+void SimpleCongruenceClosure::pop(unsigned levelCnt)
+{
+  ASS_LE(levelCnt, _levels.size());
+  if (levelCnt == 0) {
+    return;
+  }
+  _levels.truncate(_levels.size() - levelCnt + 1);
+  Level lvl = _levels.pop();
+
+  _pendingEqualities.reset();
+  while (_trail.size() > lvl.trailSize) {
+    undo(_trail.pop());
+  }
+  _negEqualities.truncate(lvl.negEqualityCnt);
+  _distinctConstraints.truncate(lvl.distinctCnt);
+  _negDistinctConstraints.truncate(lvl.negDistinctCnt);
+  _unsatEqs.reset();
+
+  unsigned maxConst = getMaxConst();
+  for (unsigned c = lvl.constCnt; c <= maxConst; c++) {
+    if (_cInfos[c].namedPair != CPair(0,0)) {
+      registerPairUse(c);
+    }
+  }
+}
+
+void SimpleCongruenceClosure::undo(const TrailEntry& e)
+{
+  switch (e.kind) {
+    case TrailEntry::Kind::MERGE: {
+      unsigned aRep = e.c1;
+      ConstInfo& aInfo = _cInfos[aRep];
+      ASS_EQ(aInfo.reprConst, e.c2);
+      _cInfos[e.c2].classList.truncate(e.n);
+      aInfo.reprConst = 0;
+      for (unsigned aChild : aInfo.classList) {
+        _cInfos[aChild].reprConst = aRep;
+      }
+
+      // the proof forest edge may have been reversed by makeProofRepresentant since
+      ConstInfo& e1Info = _cInfos[e.e1];
+      ConstInfo& e2Info = _cInfos[e.e2];
+      if (e1Info.proofPredecessor == e.e2) {
+        e1Info.proofPredecessor = 0;
+        e1Info.predecessorPremise = CEq();
+      } else {
+        ASS_EQ(e2Info.proofPredecessor, e.e1);
+        e2Info.proofPredecessor = 0;
+        e2Info.predecessorPremise = CEq();
+      }
+      break;
+    }
+    case TrailEntry::Kind::USE: {
+      // uses pushed later for good (see getPairName) may lie above this one
+      Stack<unsigned>& useList = _cInfos[e.c1].useList;
+      unsigned i = useList.size();
+      do {
+        ASS_G(i, 0);
+        i--;
+      } while (useList[i] != e.e1);
+      for (; i+1 < useList.size(); i++) {
+        useList[i] = useList[i+1];
+      }
+      useList.pop();
+      break;
+    }
+    case TrailEntry::Kind::LOOKUP:
+      ALWAYS(_lookup.remove(CPair(e.c1, e.c2)));
+      break;
+  }
 }
 
 /** Introduce fresh congruence closure constant */
@@ -214,24 +307,47 @@ unsigned SimpleCongruenceClosure::getPairName(CPair p)
   _cInfos[res].namedPair = p;
   *pRes = res;
 
+  // these insertions stay, see resetEquivalences
   _cInfos[p.first].useList.push(res);
-  if(_cInfos[p.first].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned fRepr = _cInfos[p.first].reprConst;
-    _cInfos[fRepr].useList.push(res);
-  }
   _cInfos[p.second].useList.push(res);
-  if(_cInfos[p.second].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned sRepr = _cInfos[p.second].reprConst;
-    _cInfos[sRepr].useList.push(res);
-  }
+  registerPairUse(res);
 
   return res;
 }
 
+/**
+ * Make the representatives of the arguments of the pair named by @c pairConst
+ * use it, as if it existed when their classes were merged.
+ */
+void SimpleCongruenceClosure::registerPairUse(unsigned pairConst)
+{
+  CPair p = _cInfos[pairConst].namedPair;
+  CPair derefPair = deref(p);
+  if(derefPair.first!=p.first) {
+    pushUse(derefPair.first, pairConst);
+  }
+  if(derefPair.second!=p.second) {
+    pushUse(derefPair.second, pairConst);
+  }
+
+  unsigned* pDerefPairName;
+  if(!_lookup.getValuePtr(derefPair, pDerefPairName)) {
+    if(*pDerefPairName!=pairConst) {
+      addPendingEquality(CEq(*pDerefPairName, pairConst));
+    }
+  }
+  else {
+    *pDerefPairName = pairConst;
+    _trail.push(TrailEntry{TrailEntry::Kind::LOOKUP, derefPair.first, derefPair.second, 0, pairConst, 0});
+  }
+}
+
+void SimpleCongruenceClosure::pushUse(unsigned c, unsigned pairConst)
+{
+  _cInfos[c].useList.push(pairConst);
+  _trail.push(TrailEntry{TrailEntry::Kind::USE, c, 0, 0, pairConst, 0});
+}
+
 struct SimpleCongruenceClosure::FOConversionWorker
 {
   FOConversionWorker(SimpleCongruenceClosure& parent)
@@ -390,8 +506,6 @@ SimpleCongruenceClosure::CEq SimpleCongruenceClosure::convertFOEquality(Literal*
  */
 void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualites)
 {
-  ASS(!_hadPropagated);
-
   while(lits.hasNext()) {
     Literal* l = lits.next();
     if(!l->ground()) {
@@ -470,8 +584,6 @@ void SimpleCongruenceClosure::makeProofRepresentant(unsigned c)
  */
 void SimpleCongruenceClosure::propagate()
 {
-  _hadPropagated = true;
-
   while(_pendingEqualities.isNonEmpty()) {
     CEq curr0 = _pendingEqualities.pop_back();
     CPair curr = deref(curr0);
@@ -507,6 +619,8 @@ void SimpleCongruenceClosure::propagate()
     DEBUG_CODE( aInfo.assertValid(*this, aRep); );
     DEBUG_CODE( bInfo.assertValid(*this, bRep); );
 
+    _trail.push(TrailEntry{TrailEntry::Kind::MERGE, aRep, bRep, static_cast<unsigned>(bInfo.classList.size()), curr0.c1, curr0.c2});
+
     // Merge first class into second (which is why we wanted the first to be smaller)
     // To do this we update the representative for all constants in
     // the class of aRep to be bRep
@@ -529,12 +643,13 @@ void SimpleCongruenceClosure::propagate()
       ASS(usedPair!=derefPair); // Martin: (at least) one of the arguments was aRep, now is bRep
 
       unsigned* pDerefPairName;
-      if(!_pairNames.getValuePtr(derefPair, pDerefPairName)) {
+      if(!_lookup.getValuePtr(derefPair, pDerefPairName)) {
 	addPendingEquality(CEq(*pDerefPairName, usePairConst));
       }
       else {
 	*pDerefPairName = usePairConst;
-	bInfo.useList.push(usePairConst);
+	_trail.push(TrailEntry{TrailEntry::Kind::LOOKUP, derefPair.first, derefPair.second, 0, usePairConst, 0});
+	pushUse(bRep, usePairConst);
       }
     }
   }
@@ -614,6 +729,8 @@ DecisionProcedure::Status SimpleCongruenceClosure::checkNegativeDistincts(bool r
  */
 DecisionProcedure::Status SimpleCongruenceClosure::getStatus(bool retrieveMultipleCores)
 {
+  _unsatEqs.reset();
+
   // Propagate any pending equalities
   propagate();
 
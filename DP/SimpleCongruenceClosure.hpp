@@ -40,10 +40,16 @@ using namespace Kernel;
  * explanations [the unsat core extraction] seem to be simpler and suboptimal 
  * -- the HighestNode trick ? )
  * 
- * Hint: understand _pairNames as "Lookup" from the paper.
+ * Hint: understand _lookup as "Lookup" from the paper.
  * 
  * However, classList of a representative 
  * does not (physically) contain that representative (only logically)
+ *
+ * Besides reset, the literals can be retracted by push and pop.
+ * Every change of the equivalence classes, of the use lists and of the
+ * lookup table is recorded on a trail and undone on pop,
+ * including the edges of the proof forest, so that unsat cores can
+ * be extracted at any level.
  */
 class SimpleCongruenceClosure : public DecisionProcedure
 {
@@ -60,6 +66,10 @@ public:
   
   virtual void reset() override;
 
+  bool supportsBacktracking() const override { return true; }
+  void push() override;
+  void pop(unsigned levelCnt = 1) override;
+
   /**
    * New, more fine-grained way of insertion. The terms may contain variables which are treated as constants.
    */
@@ -111,6 +121,34 @@ private:
 
   };
 
+  /** A change to be undone on pop */
+  struct TrailEntry
+  {
+    enum class Kind : uint8_t {
+      /** the class of c1 was merged into the class of c2, whose classList had size n; proof edge e1--e2 was added */
+      MERGE,
+      /** pair name e1 was pushed to the useList of c1 */
+      USE,
+      /** the pair (c1,c2) was inserted into _lookup */
+      LOOKUP
+    };
+    Kind kind;
+    unsigned c1;
+    unsigned c2;
+    unsigned n;
+    unsigned e1;
+    unsigned e2;
+  };
+
+  struct Level
+  {
+    unsigned trailSize;
+    unsigned constCnt;
+    unsigned negEqualityCnt;
+    unsigned distinctCnt;
+    unsigned negDistinctCnt;
+  };
+
   enum class SignatureKind {
     PREDICATE,
     FUNCTION,
@@ -122,6 +160,9 @@ private:
   unsigned getFreshConst();
   unsigned getSignatureConst(unsigned symbol, SignatureKind kind);
   unsigned getPairName(CPair p);
+  void registerPairUse(unsigned pairConst);
+  void pushUse(unsigned c, unsigned pairConst);
+  void undo(const TrailEntry& e);
 
 
   struct FOConversionWorker;
@@ -266,8 +307,10 @@ private:
   DHMap<std::pair<unsigned,SignatureKind>,unsigned> _sigConsts;
 
   typedef DHMap<CPair,unsigned> PairMap;
-  /** Names of constant pairs (modulo the congruence!)*/
+  /** Names of constant pairs */
   PairMap _pairNames;
+  /** Names of pairs of representatives (modulo the congruence!) */
+  PairMap _lookup;
 
   /** Constants corresponding to terms */
   DHMap<TermList,unsigned> _termNames;
@@ -296,11 +339,8 @@ private:
    * "It can be used only as a fact, not under any connective." */  
   DistinctStack _negDistinctConstraints;
 
-  /**
-   * used to assert we don't add literals after propagation.
-   * this would cause problems with term caches upon reset.
-   */
-  bool _hadPropagated;
+  Stack<TrailEntry> _trail;
+  Stack<Level> _levels;
 }; // class SimpleCongruenceClosure
 
 }
@@ -13,7 +13,20 @@
 #include "Debug/TimeProfiling.hpp"
 #include <iomanip>
 #include <cstring>
+#include <fstream>
+#include <csignal>
+#include <sys/time.h>
+#include "Lib/Environment.hpp"
+#include "Lib/Portability.hpp"
 #include "Shell/Options.hpp"
+#include "Shell/UIHelper.hpp"
+
+#if VAMPIRE_PERF_EXISTS
+#include <asm/unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
 
 namespace Shell {
 
@@ -24,6 +37,9 @@ TimeTrace::TimeTrace()
   : _root("[root]")
   , _stack({ {&_root, Clock::now(), }, }) 
   , _enabled(false)
+  , _sampleInterval(0)
+  , _current(&_root)
+  , _counterFds { -1, -1, -1, -1 }
 {  }
 
 TimeTrace::ScopedTimer::ScopedTimer(const char* name)
@@ -38,20 +54,33 @@ TimeTrace::ScopedTimer::ScopedTimer(TimeTrace& trace, const char* name)
 #endif
 {
   if (_trace._enabled) {
-    auto& children = std::get<0>(trace._stack.top())->children;
-    auto node = iterTraits(children.iter())
-      .map([](auto& x) { return &*x; })
-      .find([&](Node* n) { return n->name == name; })
-      .unwrapOrElse([&]() { 
-          children.push(std::make_unique<Node>(name));
-          return &*children.top();
-      });
+    Node* parent = std::get<0>(trace._stack.top());
+    Node* node = parent->lastEntered;
+    if (!node || node->name != name) {
+      auto& children = parent->children;
+      node = iterTraits(children.iter())
+        .map([](auto& x) { return &*x; })
+        .find([&](Node* n) { return n->name == name; })
+        .unwrapOrElse([&]() { 
+            children.push(std::make_unique<Node>(name));
+            return &*children.top();
+        });
+      parent->lastEntered = node;
+    }
+    if (_trace._sampleInterval != Duration::zero()) {
+      _trace._stack.push(std::make_pair(node, TimePoint()));
+      _trace._current = node;
+      return;
+    }
     auto start = Clock::now();
 #if VDEBUG
     _start = start;
 #endif 
 
     _trace._stack.push(std::make_pair(node, start));
+    if (_trace.counting()) {
+      _trace._counterStack.push(_trace.readCounters());
+    }
   }
 }
 
@@ -60,14 +89,139 @@ TimeTrace TimeTrace::_instance;
 void TimeTrace::setEnabled(bool v) 
 { _enabled = v; }
 
+/** The SIGPROF handler, it only touches atomics, so it does not matter which thread it runs in */
+void TimeTrace::sample(int)
+{
+  Node* node = _instance._current.load(std::memory_order_relaxed);
+  node->samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Instead of measuring the time of each block, count how often it is the innermost one when
+ * sampled every @b intervalMicros microseconds of CPU time. No sampling if @b intervalMicros is 0.
+ */
+void TimeTrace::setSampling(unsigned intervalMicros)
+{
+  if (!_enabled || !intervalMicros) {
+    return;
+  }
+  _sampleInterval = std::chrono::duration_cast<Duration>(std::chrono::microseconds(intervalMicros));
+  _current = get<0>(_stack.top());
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = sample;
+  // SIGPROF must not make waiting for children and reading from pipes fail
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGPROF, &action, nullptr);
+  startSampling();
+}
+
+/** Start the timer, it is not inherited by forked processes, so they have to call this again */
+void TimeTrace::startSampling()
+{
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(_sampleInterval).count();
+  itimerval timer;
+  timer.it_interval.tv_sec = micros / 1000000;
+  timer.it_interval.tv_usec = micros % 1000000;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+/**
+ * Also count hardware events for each block. Not together with sampling, which is meant to be
+ * cheap. Without perf events, or if they cannot be opened, nothing is counted.
+ */
+void TimeTrace::setCounting(bool v)
+{
+  if (!v || !_enabled || _sampleInterval != Duration::zero()) {
+    return;
+  }
+  openCounters();
+  if (counting()) {
+    // one entry for each open block
+    auto now = readCounters();
+    _counterStack.reset();
+    for (unsigned i = 0; i < _stack.size(); i++) {
+      _counterStack.push(now);
+    }
+  }
+}
+
+void TimeTrace::openCounters()
+{
+#if VAMPIRE_PERF_EXISTS
+  static const unsigned long long configs[] = {
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+  };
+  for (unsigned i = 0; i < 4; i++) {
+    perf_event_attr pe;
+    memset(&pe, 0, sizeof(pe));
+    pe.type = PERF_TYPE_HARDWARE;
+    pe.size = sizeof(pe);
+    pe.config = configs[i];
+    pe.disabled = i == 0; // the group is enabled through its leader
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP;
+    _counterFds[i] = syscall(__NR_perf_event_open, &pe, 0, -1, i == 0 ? -1 : _counterFds[0], 0);
+    if (_counterFds[i] == -1) {
+      addCommentSignForSZS(std::cout) << "perf_event_open failed (time statistics will not count hardware events): "
+        << strerror(errno) << std::endl;
+      closeCounters();
+      return;
+    }
+  }
+  ioctl(_counterFds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(_counterFds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void TimeTrace::closeCounters()
+{
+#if VAMPIRE_PERF_EXISTS
+  for (int& fd : _counterFds) {
+    if (fd != -1) {
+      close(fd);
+      fd = -1;
+    }
+  }
+#endif
+}
+
+TimeTrace::Counters TimeTrace::readCounters()
+{
+  Counters res;
+#if VAMPIRE_PERF_EXISTS
+  // the format of PERF_FORMAT_GROUP: the number of counters followed by their values
+  unsigned long long data[5];
+  if (read(_counterFds[0], data, sizeof(data)) == sizeof(data)) {
+    res.instructions = data[1];
+    res.cycles = data[2];
+    res.cacheMisses = data[3];
+    res.branchMisses = data[4];
+  }
+#endif
+  return res;
+}
+
 TimeTrace::ScopedTimer::~ScopedTimer()
 {
   if (_trace._enabled) {
-    auto now = Clock::now();
+    bool sampling = _trace._sampleInterval != Duration::zero();
+    // when sampling only count, the duration comes from the samples
+    auto now = sampling ? TimePoint() : Clock::now();
     auto cur = _trace._stack.pop();
     auto node = get<0>(cur);
     auto start = get<1>(cur);
+    if (sampling) {
+      _trace._current = get<0>(_trace._stack.top());
+    }
     node->measurements.add(now  - start);
+    if (_trace.counting()) {
+      node->measurements.addCounters(_trace.readCounters() - _trace._counterStack.pop());
+    }
     ASS_EQ(node->name, _name);
     ASS(start == _start);
   }
@@ -83,6 +237,23 @@ TimeTrace::ScopedChangeRoot::ScopedChangeRoot(TimeTrace& trace)
 {
   if (_trace._enabled) {
     _trace._tmpRoots.push(get<0>(trace._stack.top()));
+    // this is a new process
+    if (_trace._sampleInterval != Duration::zero()) {
+      _trace.startSampling();
+    }
+    if (_trace.counting()) {
+      // the inherited counters count the parent
+      _trace.closeCounters();
+      _trace.openCounters();
+      if (_trace.counting()) {
+        auto now = _trace.readCounters();
+        for (auto& c : _trace._counterStack) {
+          c = now;
+        }
+      } else {
+        _trace._counterStack.reset();
+      }
+    }
   }
 }
 
@@ -168,7 +339,8 @@ void TimeTrace::Node::printPrettyRec(std::ostream& out, NodeFormatOpts& opts)
     out << (opts.last ? lastChild : internalChild);
   }
   auto percent = [](Duration a, Duration b) {
-    return 100 * a / b;
+    // with sampling, blocks may have no time at all
+    return b == Duration::zero() ? 0 : 100 * a / b;
     // auto prec = 100;
     // return double(100 * prec * a / b) / prec;
   };
@@ -184,8 +356,21 @@ void TimeTrace::Node::printPrettyRec(std::ostream& out, NodeFormatOpts& opts)
 
   out << " (total: "<< msetw(4) << total
       << ", avg: "  << msetw(4) << total / cnt
-      << ", cnt: "  << msetw(6) << cnt
-      << ")" << std::endl;
+      << ", cnt: "  << msetw(6) << cnt;
+  auto& counters = measurements.counters();
+  if (counters.cycles > 0 && counters.instructions > 0) {
+    // instructions per cycle and misses per thousand instructions tell compute-bound from memory-bound
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << fixed << setprecision(2)
+        << ", Minstr: " << msetw(8) << counters.instructions / 1e6
+        << ", ipc: " << msetw(4) << double(counters.instructions) / counters.cycles
+        << ", cache-mpki: " << msetw(6) << 1000.0 * counters.cacheMisses / counters.instructions
+        << ", branch-mpki: " << msetw(6) << 1000.0 * counters.branchMisses / counters.instructions;
+    out.flags(flags);
+    out.precision(precision);
+  }
+  out << ")" << std::endl;
   std::sort(children.begin(), children.end(), [](auto& l, auto& r) { return l->totalDuration() > r->totalDuration(); });
   indent.push(indentBeforeLast);
   auto copts = opts.child(*this);
@@ -237,17 +422,77 @@ void TimeTrace::Node::flatten_(FlattenState& s)
   }
 }
 
-void TimeTrace::printPretty(std::ostream& out)
+/**
+ * Add the time estimated from the samples of this node and its descendants to the measurements,
+ * or with @b add false, remove what was added last time. Return the number of these samples.
+ */
+unsigned TimeTrace::Node::applySamples(Duration interval, bool add)
+{
+  if (add) {
+    // the handler may go on counting, so remember how much is added
+    appliedSamples = samples.load(std::memory_order_relaxed);
+  }
+  unsigned total = 0;
+  for (auto& c : children) {
+    total += c->applySamples(interval, add);
+  }
+  if (add) {
+    appliedSamples += total;
+  }
+  measurements.addToSum(add ? interval * appliedSamples : -interval * appliedSamples);
+  return appliedSamples;
+}
+
+/**
+ * Let the scopes that are still open count as if they ended @b now, and when sampling, add the
+ * time estimated from the samples.
+ */
+void TimeTrace::addOpenScopes(TimePoint now)
 {
+  bool sampling = _sampleInterval != Duration::zero();
+  if (sampling) {
+    _root.applySamples(_sampleInterval, true);
+  }
+  for (auto& x : _stack) {
+    auto node = get<0>(x);
+    auto start = get<1>(x);
+    node->measurements.add(sampling ? Duration::zero() : now - start);
+  }
+  if (counting()) {
+    ASS_EQ(_counterStack.size(), _stack.size());
+    _openCounters = readCounters();
+    for (unsigned i = 0; i < _stack.size(); i++) {
+      get<0>(_stack[i])->measurements.addCounters(_openCounters - _counterStack[i]);
+    }
+  }
+}
 
-  auto now = Clock::now();
+/** Undo addOpenScopes(now) */
+void TimeTrace::removeOpenScopes(TimePoint now)
+{
+  bool sampling = _sampleInterval != Duration::zero();
+  if (sampling) {
+    _root.applySamples(_sampleInterval, false);
+  }
   for (auto& x : _stack) {
     auto node = get<0>(x);
     auto start = get<1>(x);
-    node->measurements.add(now - start);
+    node->measurements.remove(sampling ? Duration::zero() : now - start);
   }
+  if (counting()) {
+    for (unsigned i = 0; i < _stack.size(); i++) {
+      get<0>(_stack[i])->measurements.addCounters(_counterStack[i] - _openCounters);
+    }
+  }
+}
 
-  auto& root = _tmpRoots.size() == 0 ? _root : *_tmpRoots.top();
+void TimeTrace::printPretty(std::ostream& out)
+{
+
+  auto now = Clock::now();
+  addOpenScopes(now);
+
+  auto& root = currentRoot();
   Stack<const char*> indent;
   auto rootOpts = Node::NodeFormatOpts::root(indent);
 
@@ -263,12 +508,199 @@ void TimeTrace::printPretty(std::ostream& out)
   root.flatten().printPrettyRec(out, rootOpts);
   out << "===== end of flattened time profile =====" << std::endl;
 
+  removeOpenScopes(now);
+}
 
-  for (auto& x : _stack) {
-    auto node = get<0>(x);
-    auto start = get<1>(x);
-    node->measurements.remove(now - start);
+static void printJsonString(std::ostream& out, const char* str)
+{
+  out << '"';
+  for (const char* c = str; *c; c++) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\';
+    }
+    out << *c;
+  }
+  out << '"';
+}
+
+static void printJsonCounters(std::ostream& out, TimeTrace::Counters const& counters)
+{
+  if (counters.cycles > 0) {
+    out << ", \"instructions\": " << counters.instructions
+        << ", \"cycles\": " << counters.cycles
+        << ", \"cache_misses\": " << counters.cacheMisses
+        << ", \"branch_misses\": " << counters.branchMisses;
+  }
+}
+
+void TimeTrace::Node::printJson(std::ostream& out)
+{
+  out << "{\"name\": ";
+  printJsonString(out, name);
+  out << ", \"total_ns\": " << chrono::duration_cast<chrono::nanoseconds>(totalDuration()).count()
+      << ", \"count\": " << measurements.cnt();
+  printJsonCounters(out, measurements.counters());
+  out << ", \"children\": [";
+  for (unsigned i = 0; i < children.size(); i++) {
+    out << (i ? ", " : "");
+    children[i]->printJson(out);
+  }
+  out << "]}";
+}
+
+/**
+ * Print a complete event for this node starting at @b start and the events of its children, one
+ * after the other. Only the durations are known, so this only shows where the time went, not when.
+ * Return the duration of the event, which also covers the children, as the children of a node
+ * merged from several processes may take longer than the node itself.
+ */
+TimeTrace::Duration TimeTrace::Node::printChromeEvents(std::ostream& out, Duration start, bool& first)
+{
+  std::sort(children.begin(), children.end(), [](auto& l, auto& r) { return l->totalDuration() > r->totalDuration(); });
+  Duration end = start;
+  for (auto& c : children) {
+    end += c->printChromeEvents(out, end, first);
+  }
+  Duration duration = std::max(totalDuration(), end - start);
+
+  using Micros = chrono::duration<double, std::micro>;
+  out << (first ? "\n" : ",\n") << "{\"name\": ";
+  printJsonString(out, name);
+  out << ", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+      << ", \"ts\": " << Micros(start).count()
+      << ", \"dur\": " << Micros(duration).count()
+      << ", \"args\": {\"count\": " << measurements.cnt();
+  printJsonCounters(out, measurements.counters());
+  out << "}}";
+  first = false;
+  return duration;
+}
+
+/**
+ * Write the trace to the time_statistics_file, if there is one. Child processes, which have
+ * changed the root, do not write the file, portfolio mode merges their traces into the one of the
+ * parent instead.
+ */
+void TimeTrace::exportToFile()
+{
+  const std::string& path = env.options->timeStatisticsFile();
+  if (path.empty() || _tmpRoots.size() > 0) {
+    return;
+  }
+  std::ofstream out(path);
+  if (out.fail()) {
+    addCommentSignForSZS(std::cout) << "Failed to write time statistics to '" << path << "'" << std::endl;
+    return;
+  }
+
+  auto now = Clock::now();
+  addOpenScopes(now);
+  switch (env.options->timeStatisticsFormat()) {
+    case Options::TimeStatisticsFormat::JSON:
+      _root.printJson(out);
+      out << std::endl;
+      break;
+    case Options::TimeStatisticsFormat::CHROME: {
+      bool first = true;
+      out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+      _root.printChromeEvents(out, Duration(0), first);
+      out << "\n]}" << std::endl;
+      break;
+    }
+  }
+  removeOpenScopes(now);
+}
+
+/**
+ * One line per node, in preorder: depth, count, total nanoseconds, the counters and name. This is
+ * the format read by merge.
+ */
+void TimeTrace::Node::serialize(std::ostream& out, unsigned depth)
+{
+  auto& counters = measurements.counters();
+  out << depth << ' ' << measurements.cnt() << ' '
+      << chrono::duration_cast<chrono::nanoseconds>(totalDuration()).count() << ' '
+      << counters.instructions << ' ' << counters.cycles << ' '
+      << counters.cacheMisses << ' ' << counters.branchMisses << ' ' << name << '\n';
+  for (auto& c : children) {
+    c->serialize(out, depth + 1);
+  }
+}
+
+/**
+ * Write the tree below the current root, including the root, so that another process can merge
+ * it into its trace.
+ */
+void TimeTrace::serialize(std::ostream& out)
+{
+  auto now = Clock::now();
+  addOpenScopes(now);
+  currentRoot().serialize(out, 0);
+  removeOpenScopes(now);
+}
+
+/** Add the measurements and children of @b other to this node, @b other is left empty */
+void TimeTrace::Node::merge(Node& other)
+{
+  measurements.extend(other.measurements);
+  for (auto& oc : other.children) {
+    auto c = iterTraits(children.iter())
+      .map([](auto& x) { return &*x; })
+      .find([&](Node* n) { return strcmp(n->name, oc->name) == 0; });
+    if (c.isSome()) {
+      c.unwrap()->merge(*oc);
+    } else {
+      children.push(std::move(oc));
+    }
+  }
+  other.children.reset();
+  other.lastEntered = nullptr;
+}
+
+const char* TimeTrace::mergedName(const std::string& name)
+{
+  auto found = iterTraits(_mergedNames.iter())
+    .find([&](auto& n) { return *n == name; });
+  if (found.isSome()) {
+    return found.unwrap()->c_str();
+  }
+  _mergedNames.push(std::make_unique<std::string>(name));
+  return _mergedNames.top()->c_str();
+}
+
+/**
+ * Read trees written by serialize and add them as children of the innermost open scope, adding
+ * up the measurements of nodes with the same name. Used by the portfolio parent to aggregate the
+ * traces of all the slices it has run.
+ */
+void TimeTrace::merge(std::istream& in)
+{
+  if (!_enabled) {
+    return;
+  }
+  Node read("");
+  Stack<Node*> path;
+  path.push(&read);
+
+  unsigned depth;
+  unsigned cnt;
+  long long nanos;
+  Counters counters;
+  std::string name;
+  while (in >> depth >> cnt >> nanos
+            >> counters.instructions >> counters.cycles >> counters.cacheMisses >> counters.branchMisses
+         && in.get() == ' ' && getline(in, name)) {
+    if (depth >= path.size()) {
+      // malformed, e.g. written by a process that was killed
+      break;
+    }
+    path.truncate(depth + 1);
+    auto node = std::make_unique<Node>(mergedName(name));
+    node->measurements = Measurements(chrono::duration_cast<Duration>(chrono::nanoseconds(nanos)), cnt, counters);
+    path.top()->children.push(std::move(node));
+    path.push(&*path.top()->children.top());
   }
+  get<0>(_stack.top())->merge(read);
 }
 
 } // namespace Shell
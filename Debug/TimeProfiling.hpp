@@ -15,6 +15,7 @@
 #include "Lib/Stack.hpp"
 #include "Lib/Option.hpp"
 #include "Debug/Assertion.hpp"
+#include <atomic>
 #include <chrono>
 #include "Lib/MacroUtils.hpp"
 
@@ -42,7 +43,10 @@ namespace Shell {
  * recursive functions.
  * Further it should be noted that the macro introduces some overhead, hence it should also be
  * avoided to be used in parts of the codebase that are called very often and only perform short
- * tasks.
+ * tasks. With time_statistics_sampling the clock is not read, a SIGPROF handler counts how often
+ * each block is the innermost one instead, which is cheaper but less precise.
+ * With time_statistics_counters, instructions, cycles, cache misses and branch mispredictions are
+ * also counted for each block, which costs a system call on entering and leaving it.
  * ```
  */
 #define TIME_TRACE(name)                                                                            \
@@ -59,6 +63,8 @@ namespace Shell {
  * sets a new node as the root of the time trace. this is useful when launching child process.
  * The subtree will be set to the original root, when the call of TIME_TRACE_NEW_ROOT goes out of
  * scope.  Therefore the statistics must be outputted before that to see any effect of this call.
+ * Portfolio mode has its children serialize the tree below the new root when they are done, and
+ * merges these trees into its own, so that its statistics cover all the slices run.
  */
 #define TIME_TRACE_NEW_ROOT(name)                                                                   \
   TIME_TRACE(name)                                                                                  \
@@ -107,11 +113,34 @@ private:
   TimeTrace(TimeTrace     &&) = delete;
   TimeTrace(TimeTrace const&) = delete;
 
+public:
+  /** Hardware event counts, see TimeTrace::setCounting */
+  struct Counters {
+    long long instructions = 0;
+    long long cycles = 0;
+    long long cacheMisses = 0;
+    long long branchMisses = 0;
+
+    Counters& operator+=(Counters const& o) {
+      instructions += o.instructions;
+      cycles += o.cycles;
+      cacheMisses += o.cacheMisses;
+      branchMisses += o.branchMisses;
+      return *this;
+    }
+    Counters operator-() const { return { -instructions, -cycles, -cacheMisses, -branchMisses }; }
+    Counters operator-(Counters const& o) const { return Counters(*this) += -o; }
+  };
+
+private:
   class Measurements {
     Duration _sum;
     unsigned _cnt;
+    Counters _counters;
 
   public:
+    Measurements() : _sum(0), _cnt(0) {}
+    Measurements(Duration sum, unsigned cnt, Counters counters) : _sum(sum), _cnt(cnt), _counters(counters) {}
     void add(Duration d) {
       _cnt += 1;
       _sum += d;
@@ -123,9 +152,14 @@ private:
     Duration sum() const { return _sum; }
     unsigned cnt() const { return _cnt; }
     Duration avg() const { return sum() / cnt(); }
+    /** for the durations derived from samples */
+    void addToSum(Duration d) { _sum += d; }
+    Counters const& counters() const { return _counters; }
+    void addCounters(Counters const& c) { _counters += c; }
     void extend(Measurements other) {
       _sum += other._sum;
       _cnt += other._cnt;
+      _counters += other._counters;
     }
   };
 
@@ -135,12 +169,25 @@ private:
     const char* name;
     Lib::Stack<std::unique_ptr<Node>> children;
     Measurements measurements;
-    Node(const char* name) : name(name), children(), measurements() {}
+    /** the number of samples taken while this was the innermost block, see TimeTrace::sample */
+    std::atomic<unsigned> samples;
+    /** the samples of the node and its descendants counted in the measurements by applySamples */
+    unsigned appliedSamples;
+    /** the child entered last, checked before searching the children by name */
+    Node* lastEntered;
+    Node(const char* name) : name(name), children(), measurements(), samples(0), appliedSamples(0), lastEntered(nullptr) {}
+    Node(Node&& other)
+      : name(other.name), children(std::move(other.children)), measurements(other.measurements),
+        samples(other.samples.load()), appliedSamples(other.appliedSamples), lastEntered(other.lastEntered) {}
     struct NodeFormatOpts ;
     void printPrettyRec(std::ostream& out, NodeFormatOpts& opts);
     void printPrettySelf(std::ostream& out, NodeFormatOpts& opts);
-    void serialize(std::ostream& out);
+    void serialize(std::ostream& out, unsigned depth);
+    void printJson(std::ostream& out);
+    Duration printChromeEvents(std::ostream& out, Duration start, bool& first);
+    void merge(Node& other);
     Duration totalDuration() const;
+    unsigned applySamples(Duration interval, bool add);
 
     Node flatten();
     struct FlattenState;
@@ -176,14 +223,40 @@ public:
   };
 
   void printPretty(std::ostream& out);
+  void exportToFile();
   void serialize(std::ostream& out);
+  void merge(std::istream& in);
   void setEnabled(bool);
+  void setSampling(unsigned intervalMicros);
+  void setCounting(bool);
 private:
+  static void sample(int);
+  void startSampling();
+  bool counting() const { return _counterFds[0] != -1; }
+  void openCounters();
+  void closeCounters();
+  Counters readCounters();
+  Node& currentRoot() { return _tmpRoots.size() == 0 ? _root : *_tmpRoots.top(); }
+  void addOpenScopes(TimePoint now);
+  void removeOpenScopes(TimePoint now);
+  const char* mergedName(const std::string& name);
 
   Node _root;
   Lib::Stack<Node*> _tmpRoots;
   Lib::Stack<std::tuple<Node*, TimePoint>> _stack;
+  /** names of the nodes read by merge, the nodes point into them */
+  Lib::Stack<std::unique_ptr<std::string>> _mergedNames;
   bool _enabled;
+  /** if not zero, the blocks are not timed but sampled with this period of CPU time */
+  Duration _sampleInterval;
+  /** the innermost block for the signal handler sampling it */
+  std::atomic<Node*> _current;
+  /** perf event file descriptors, the first one leads the group, -1 if not counting */
+  int _counterFds[4];
+  /** the counters when the blocks of _stack were entered */
+  Lib::Stack<Counters> _counterStack;
+  /** the counters read by addOpenScopes */
+  Counters _openCounters;
 };
 
 #endif // VTIME_PROFILING
@@ -17,6 +17,11 @@
  */
 
 #include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 #include "Debug/Tracer.hpp"
 
@@ -34,6 +39,7 @@
 
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/BufferedSolver.hpp"
+#include "SAT/TracingSolver.hpp"
 
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
@@ -43,6 +49,7 @@
 #include "Lib/Random.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/ArrayMap.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
 
 #include "Shell/UIHelper.hpp"
 #include "Shell/TPTPPrinter.hpp"
@@ -72,6 +79,7 @@ namespace FMB
 {
 
 using namespace std;
+using Lib::Sys::Multiprocessing;
 
 FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
 : MainLoop(prb, opt), _sortedSignature(0), _groundClauses(0), _clauses(0),
@@ -135,6 +143,13 @@ FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
     default:
       ASSERTION_VIOLATION;
   }
+
+  _lazyInstances = opt.fmbLazyInstances();
+  _onlyViolatedInstances = false;
+  _clausesAdded = 0;
+  // the contour strategy has its own markers for the sizes
+  _incremental = opt.fmbIncremental() && !_xmass;
+  _freshSolver = true;
 }
 
 FiniteModelBuilder::~FiniteModelBuilder()
@@ -148,6 +163,10 @@ FiniteModelBuilder::~FiniteModelBuilder()
 // Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
 // large signatures and large models. If this a frequent problem then we can go to longs.
 bool FiniteModelBuilder::reset(){
+  if (_incremental) {
+    return resetIncremental();
+  }
+
   // Construct the offsets for symbols
   // Each symbol requires size^n) variables where n is the number of spaces for grounding
   // For function symbols we have n=arity+1 as we have the return value
@@ -253,12 +272,7 @@ bool FiniteModelBuilder::reset(){
     offsets += add;
   }
 
-  // Create a new SAT solver
-  try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
-  }catch(Minisat::OutOfMemoryException&){
-    MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
-  }
+  createSolver();
 
   /*
   if(_opt.satSolver() != Options::SatSolver::MINISAT){
@@ -286,6 +300,8 @@ bool FiniteModelBuilder::reset(){
   // set the number of SAT variables, this could cause an exception
   _curMaxVar = offsets-1;
   _solver->ensureVarCount(_curMaxVar);
+  _clausesAdded = 0;
+  _freshSolver = true;
 
   // needs to be redone for each size as we use this to pick the number of
   // things to order and the constants to ground with 
@@ -294,6 +310,86 @@ bool FiniteModelBuilder::reset(){
   return true;
 }
 
+void FiniteModelBuilder::createSolver()
+{
+  try{
+    MinisatInterfacingNewSimp* minisat = new MinisatInterfacingNewSimp(_opt,true);
+    if (_lazyInstances || _incremental) {
+      // clauses will be added over the variables after solving
+      minisat->disableVariableElimination();
+    }
+    _solver = TracingSolver::traceIfRequested(minisat,_opt,"fmb");
+  }catch(Minisat::OutOfMemoryException&){
+    MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+  }
+}
+
+/**
+ * The reset for fmb_incremental. The solver is kept if no sort got smaller,
+ * so only the clauses mentioning the new domain elements need to be added.
+ *
+ * Variables of grounded symbols are then allocated on demand (see getSATLiteral).
+ * The clauses specific to the sizes are guarded: totality by a marker per distinct sort,
+ * replaced once the size of the sort changes, and the symmetry axioms by a selector per size assignment.
+ * The guards of the old sizes are then disabled by unit clauses.
+ */
+bool FiniteModelBuilder::resetIncremental()
+{
+  unsigned distinctSorts = _distinctSortSizes.size();
+
+  _freshSolver = !_solver;
+  for (unsigned s = 0; !_freshSolver && s < _sortedSignature->sorts; s++) {
+    if (_sortModelSizes[s] < _encodedSortSizes[s]) {
+      _freshSolver = true;
+    }
+  }
+
+  _clausesAdded = 0;
+  if (_freshSolver) {
+    createSolver();
+    _groundVars.reset();
+    _curMaxVar = 0;
+    _encodedSortSizes.init(_sortedSignature->sorts, 0);
+    _encodedDistinctSortSizes.init(distinctSorts, 0);
+    _totalityMarkers.ensure(distinctSorts);
+
+    instancesMarker_offset = _curMaxVar+1;
+    _curMaxVar += distinctSorts;
+  } else {
+    addSATClause(SATLiteral(_symmetrySelector,0));
+  }
+
+  _freshTotality.ensure(distinctSorts);
+  for (unsigned i = 0; i < distinctSorts; i++) {
+    _freshTotality[i] = _distinctSortSizes[i] != _encodedDistinctSortSizes[i];
+    if (_freshTotality[i]) {
+      if (!_freshSolver) {
+        addSATClause(SATLiteral(_totalityMarkers[i],0));
+      }
+      _totalityMarkers[i] = ++_curMaxVar;
+    }
+  }
+  _symmetrySelector = ++_curMaxVar;
+  _solver->ensureVarCount(_curMaxVar);
+
+  createSymmetryOrdering();
+  return true;
+}
+
+/**
+ * Are all the elements of @b grounding, where the i-th one is of sort @b sorts[i],
+ * within the sizes already encoded by the kept solver of fmb_incremental?
+ */
+bool FiniteModelBuilder::alreadyEncoded(const DArray<unsigned>& grounding, const DArray<unsigned>& sorts)
+{
+  for (unsigned i = 0; i < grounding.size(); i++) {
+    if (grounding[i] > _encodedSortSizes[sorts[i]]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Compare function symbols by their usage in the problem
 struct FMBSymmetryFunctionComparator
 {
@@ -943,6 +1039,8 @@ void FiniteModelBuilder::addGroundClauses()
 {
   // If we don't have any ground clauses don't do anything
   if(!_groundClauses) return;
+  // they are already there
+  if(!_freshSolver) return;
 
   ClauseList::Iterator cit(_groundClauses);
 
@@ -1058,6 +1156,9 @@ instanceLabel:
       else{
         grounding[var]++;
         // Grounding represents a new instance
+        if (!_freshSolver && !_onlyViolatedInstances && alreadyEncoded(grounding,*varSorts)) {
+          goto instanceLabel;
+        }
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
 
@@ -1149,6 +1250,10 @@ instanceLabel:
           }
         }
      
+        if (_onlyViolatedInstances && trueInModel(satClauseLits)) {
+          goto instanceLabel;
+        }
+
         SATClause* satCl = SATClause::fromStack(satClauseLits);
         addSATClause(satCl);
 
@@ -1215,6 +1320,12 @@ void FiniteModelBuilder::addNewFunctionalDefs()
       maxVarSize[var] = min(_sortedSignature->sortBounds[srt],_sortModelSizes[srt]);
     }
 
+    // the sorts of [y,z,x1,x2,...]
+    static DArray<unsigned> groundingSorts;
+    groundingSorts.ensure(arity+2);
+    groundingSorts[0] = groundingSorts[1] = returnSrt;
+    for(unsigned var=2;var<arity+2;var++){ groundingSorts[var] = f_signature[var-2]; }
+
     static DArray<unsigned> grounding;
     grounding.ensure(arity+2);
     for(unsigned var=0;var<arity+2;var++){ grounding[var]=1; }
@@ -1237,6 +1348,9 @@ newFuncLabel:
             //Skip this instance
             goto newFuncLabel;
           }
+          if(!_freshSolver && alreadyEncoded(grounding,groundingSorts)){
+            goto newFuncLabel;
+          }
           static SATLiteralStack satClauseLits;
           satClauseLits.reset();
 
@@ -1283,6 +1397,9 @@ void FiniteModelBuilder::addNewSymmetryOrderingAxioms(unsigned size,
     SATLiteral sl = getSATLiteral(gt.f,grounding,true,true);
     satClauseLits.push(sl);
   }
+  if (_incremental) {
+    satClauseLits.push(SATLiteral(_symmetrySelector,0));
+  }
   SATClause* satCl = SATClause::fromStack(satClauseLits);
   addSATClause(satCl);
 
@@ -1326,6 +1443,9 @@ void FiniteModelBuilder::addNewSymmetryCanonicityAxioms(unsigned size,
 
         satClauseLits.push(getSATLiteral(gtj.f,grounding_j,true,true));
       }
+      if (_incremental) {
+        satClauseLits.push(SATLiteral(_symmetrySelector,0));
+      }
       addSATClause(SATClause::fromStack(satClauseLits));
   }
 
@@ -1401,6 +1521,10 @@ void FiniteModelBuilder::addNewTotalityDefs()
       unsigned srt = f_signature[0];
       unsigned dsrt = _sortedSignature->parents[srt];
       unsigned maxSize = min(_sortedSignature->sortBounds[srt],_sortModelSizes[srt]);
+      if (!_freshSolver && !_freshTotality[dsrt]) {
+        // the totality of the constant did not change
+        continue;
+      }
 
       // cout << "Totality for const " << f << " of sort " << srt << " and max size " << maxSize << endl;
 
@@ -1420,7 +1544,7 @@ void FiniteModelBuilder::addNewTotalityDefs()
           ///cout << "out sort " << dsrt;
           // cout << "  version for size " << i << " marked with " << i-1 << " positive" << endl;
         } else {
-          satClauseLits.push(SATLiteral(totalityMarker_offset+dsrt,0));
+          satClauseLits.push(SATLiteral(totalityMarker(dsrt),0));
         }
 
         SATClause* satCl = SATClause::fromStack(satClauseLits);
@@ -1456,6 +1580,9 @@ newTotalLabel:
           //cout << "Grounding: ";
           //for(unsigned j=0;j<grounding.size();j++) cout << grounding[j] << " ";
           //cout << endl;
+          if (!_freshSolver && !_freshTotality[dRetSrt] && alreadyEncoded(grounding,f_signature)) {
+            goto newTotalLabel;
+          }
 
           for (unsigned i = (!_xmass || (_sortedSignature->monotonicSorts[dRetSrt])) ? maxRtSrtSize : 1; i <= maxRtSrtSize; i++) {
             static SATLiteralStack satClauseLits;
@@ -1472,7 +1599,7 @@ newTotalLabel:
               unsigned marker_idx = (i == maxRtSrtSize) ? _distinctSortSizes[dRetSrt]-1 : i-1; // use the largest marker for the largest version even if it is smaller than _distinctSortSizes[dsrt]
               satClauseLits.push(SATLiteral(SATLiteral(marker_offsets[dRetSrt]+marker_idx,1)));
             } else {
-              satClauseLits.push(SATLiteral(totalityMarker_offset+dRetSrt,0));
+              satClauseLits.push(SATLiteral(totalityMarker(dRetSrt),0));
             }
             SATClause* satCl = SATClause::fromStack(satClauseLits);
             addSATClause(satCl);
@@ -1500,6 +1627,22 @@ SATLiteral FiniteModelBuilder::getSATLiteral(unsigned f, const DArray<unsigned>&
   );
   ASS((isFunction && arity==grounding.size()-1) || (!isFunction && arity==grounding.size()));
 
+  if (_incremental) {
+    static Stack<unsigned> key;
+    key.reset();
+    key.push(isFunction ? 2*f : 2*f+1);
+    for(unsigned i=0;i<grounding.size();i++){
+      key.push(grounding[i]);
+    }
+    unsigned var;
+    if (!_groundVars.find(key,var)) {
+      var = ++_curMaxVar;
+      _solver->ensureVarCount(_curMaxVar);
+      _groundVars.insert(key,var);
+    }
+    return SATLiteral(var,polarity);
+  }
+
   unsigned offset = isFunction ? f_offsets[f] : p_offsets[f];
 
   //cout << "getSATLiteral " << f<< ","  << offset << ", grounding = ";
@@ -1532,7 +1675,26 @@ void FiniteModelBuilder::addSATClause(SATClause* cl)
 #endif
 
   _clausesToBeAdded.push(cl);
+  if (_clausesToBeAdded.size() >= CLAUSE_CHUNK_SIZE) {
+    flushClauses();
+  }
+}
+
+void FiniteModelBuilder::flushClauses()
+{
+  if (_opt.randomTraversals()) {
+    TIME_TRACE(TimeTrace::SHUFFLING);
+    Shuffling::shuffleArray(_clausesToBeAdded,_clausesToBeAdded.size());
+  }
+  _solver->addClausesIter(pvi(SATClauseStack::ConstIterator(_clausesToBeAdded)));
+  _clausesAdded += _clausesToBeAdded.size();
 
+  // the solver keeps its own copy
+  SATClauseStack::Iterator it(_clausesToBeAdded);
+  while (it.hasNext()) {
+    it.next()->destroy();
+  }
+  _clausesToBeAdded.reset();
 }
 
 MainLoopResult FiniteModelBuilder::runImpl()
@@ -1590,85 +1752,17 @@ MainLoopResult FiniteModelBuilder::runImpl()
     if (!_dsaEnumerator->init(_startModelSize,_distinctSortSizes,_distinct_sort_constraints,_strict_distinct_sort_constraints)) {
       goto gave_up;
     }
+    if (_opt.fmbWorkers() > 1) {
+      return runParallel();
+    }
   }
 
   if (reset()) {
   while(true){
-    if(outputAllowed()) {
-      cout << "% TRYING " << "[";
-      for(unsigned i=0;i<_distinctSortSizes.size();i++){
-        cout << _distinctSortSizes[i];
-        if(i+1 < _distinctSortSizes.size()) cout << ",";
-      }
-      cout << "]" << endl;
-    }
-    {
-    TIME_TRACE("fmb constraint creation");
-
-    // add the new clauses to _clausesToBeAdded
-#if VTRACE_FMB
-    cout << "GROUND" << endl;
-#endif
-    addGroundClauses();
-#if VTRACE_FMB
-    cout << "INSTANCES" << endl;
-#endif
-    addNewInstances();
-#if VTRACE_FMB
-    cout << "FUNC DEFS" << endl;
-#endif
-    addNewFunctionalDefs();
-#if VTRACE_FMB
-    cout << "SYM DEFS" << endl;
-#endif
-    addNewSymmetryAxioms();
-    
-#if VTRACE_FMB
-    cout << "TOTAL DEFS" << endl;
-#endif
-    addNewTotalityDefs();
+    outputTrying();
 
-    }
-
-#if VTRACE_FMB
-    cout << "SOLVING" << endl;
-#endif
-    //TODO consider adding clauses directly to SAT solver in new interface?
-    // pass clauses and assumption to SAT Solver
-    SATSolver::Status satResult = SATSolver::Status::UNKNOWN;
-    {
-      if (_opt.randomTraversals()) {
-        TIME_TRACE(TimeTrace::SHUFFLING);
-        Shuffling::shuffleArray(_clausesToBeAdded,_clausesToBeAdded.size());
-      }
-      TIME_TRACE("fmb sat solving");
-
-      _solver->addClausesIter(pvi(SATClauseStack::ConstIterator(_clausesToBeAdded)));
-
-      env.statistics->phase = Statistics::FMB_SOLVING;
-
-      static SATLiteralStack assumptions(_distinctSortSizes.size());
-      assumptions.reset();
-      if (_xmass) {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
-          // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
-        }
-      } else {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(totalityMarker_offset+i,1));
-        }
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(instancesMarker_offset+i,1));
-        }
-      }
-
-      if (_opt.randomTraversals()) {
-        _solver->randomizeForNextAssignment(_curMaxVar);
-      }
-      satResult = _solver->solveUnderAssumptions(assumptions);
-      env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
-    }
+    unsigned weight;
+    SATSolver::Status satResult = encodeAndSolve(weight);
 
     // if the clauses are satisfiable then we have found a finite model
     if(satResult == SATSolver::Status::SATISFIABLE){
@@ -1709,17 +1803,6 @@ MainLoopResult FiniteModelBuilder::runImpl()
       return MainLoopResult(Statistics::SATISFIABLE);
     }
 
-    unsigned clauseSetSize = _clausesToBeAdded.size();
-    unsigned weight = clauseSetSize;
-
-    // destroy the clauses
-    SATClauseStack::Iterator it(_clausesToBeAdded);
-    while (it.hasNext()) {
-      it.next()->destroy();
-    }
-    // but the container needs to be empty for the next round in any case
-    _clausesToBeAdded.reset();
-
     {
       // _solver->explicitlyMinimizedFailedAssumptions(false,true); // TODO: try adding this in
       const SATLiteralStack& failed = _solver->failedAssumptions();
@@ -1803,29 +1886,7 @@ MainLoopResult FiniteModelBuilder::runImpl()
         }
       } else { // i.e. (!_xmass)
         static Constraint_Generator_Vals nogood;
-
-        nogood.ensure(_distinctSortSizes.size());
-
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          nogood[i] = make_pair(STAR,_distinctSortSizes[i]);
-        }
-
-        for (unsigned i = 0; i < failed.size(); i++) {
-          unsigned var = failed[i].var();
-          ASS_GE(var,totalityMarker_offset);
-
-          if (var < instancesMarker_offset) { // totality used (-> instances used as well / unless the sort is monotonic)
-            unsigned dsort = var-totalityMarker_offset;
-            if (_sortedSignature->monotonicSorts[dsort]) {
-              nogood[dsort].first = LEQ;
-            } else {
-              nogood[dsort].first = EQ;
-            }
-          } else if (nogood[var-instancesMarker_offset].first == STAR) { // instances used (and we don't know yet about totality)
-            ASS(!_sortedSignature->monotonicSorts[var-instancesMarker_offset]);
-            nogood[var-instancesMarker_offset].first = GEQ;
-          }
-        }
+        nogoodFromFailedAssumptions(nogood);
 
 #if VTRACE_DOMAINS
         cout << "Learned a nogood: ";
@@ -1879,6 +1940,544 @@ MainLoopResult FiniteModelBuilder::runImpl()
   return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
 }
 
+void FiniteModelBuilder::outputTrying()
+{
+  if(outputAllowed()) {
+    cout << "% TRYING " << "[";
+    for(unsigned i=0;i<_distinctSortSizes.size();i++){
+      cout << _distinctSortSizes[i];
+      if(i+1 < _distinctSortSizes.size()) cout << ",";
+    }
+    cout << "]" << endl;
+  }
+}
+
+SATSolver::Status FiniteModelBuilder::encodeAndSolve(unsigned& weight)
+{
+  unsigned encodingMs = 0;
+  unsigned solvingMs = 0;
+  unsigned start = Timer::elapsedMilliseconds();
+
+  {
+  TIME_TRACE("fmb constraint creation");
+
+  // the clauses go to the solver in chunks as they are created
+#if VTRACE_FMB
+  cout << "GROUND" << endl;
+#endif
+  addGroundClauses();
+  if (!_lazyInstances) {
+#if VTRACE_FMB
+    cout << "INSTANCES" << endl;
+#endif
+    addNewInstances();
+  }
+#if VTRACE_FMB
+  cout << "FUNC DEFS" << endl;
+#endif
+  addNewFunctionalDefs();
+#if VTRACE_FMB
+  cout << "SYM DEFS" << endl;
+#endif
+  addNewSymmetryAxioms();
+
+#if VTRACE_FMB
+  cout << "TOTAL DEFS" << endl;
+#endif
+  addNewTotalityDefs();
+
+  flushClauses();
+  }
+
+  if (_incremental) {
+    _encodedSortSizes.initFromArray(_sortModelSizes.size(), _sortModelSizes);
+    _encodedDistinctSortSizes.initFromArray(_distinctSortSizes.size(), _distinctSortSizes);
+  }
+  encodingMs += Timer::elapsedMilliseconds() - start;
+
+  static SATLiteralStack assumptions(_distinctSortSizes.size());
+  assumptions.reset();
+  if (_xmass) {
+    for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+      assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
+      // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
+    }
+  } else {
+    for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+      assumptions.push(SATLiteral(totalityMarker(i),1));
+    }
+    for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+      assumptions.push(SATLiteral(instancesMarker_offset+i,1));
+    }
+    if (_incremental) {
+      assumptions.push(SATLiteral(_symmetrySelector,1));
+    }
+  }
+
+  SATSolver::Status satResult = SATSolver::Status::UNKNOWN;
+  while (true) {
+#if VTRACE_FMB
+    cout << "SOLVING" << endl;
+#endif
+    start = Timer::elapsedMilliseconds();
+    {
+      TIME_TRACE("fmb sat solving");
+      env.statistics->phase = Statistics::FMB_SOLVING;
+
+      if (_opt.randomTraversals()) {
+        _solver->randomizeForNextAssignment(_curMaxVar);
+      }
+      satResult = _solver->solveUnderAssumptions(assumptions);
+      env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
+    }
+    solvingMs += Timer::elapsedMilliseconds() - start;
+
+    if (!_lazyInstances || satResult != SATSolver::Status::SATISFIABLE) {
+      break;
+    }
+
+    // with lazy instances, the model is one when no instance is false in it
+    unsigned clausesBefore = _clausesAdded;
+    start = Timer::elapsedMilliseconds();
+    {
+      TIME_TRACE("fmb constraint creation");
+      _onlyViolatedInstances = true;
+      addNewInstances();
+      _onlyViolatedInstances = false;
+      flushClauses();
+    }
+    encodingMs += Timer::elapsedMilliseconds() - start;
+    if (_clausesAdded == clausesBefore) {
+      break;
+    }
+  }
+
+  // the weight of a nogood measures the whole encoding of the sizes, but in incremental
+  // mode or with lazy instances only a part of it was added for them
+  weight = (_incremental || _lazyInstances) ? estimateInstanceCount() : _clausesAdded;
+
+  env.statistics->fmbSizeAttemptCount++;
+  if (env.statistics->fmbSizeAttempts.size() < Statistics::FMB_SIZE_ATTEMPTS_KEPT) {
+    Statistics::FmbSizeAttempt attempt;
+    attempt.sizes.initFromArray(_distinctSortSizes.size(), _distinctSortSizes);
+    attempt.clauses = _clausesAdded;
+    attempt.encodingMs = encodingMs;
+    attempt.solvingMs = solvingMs;
+    env.statistics->fmbSizeAttempts.push(std::move(attempt));
+  }
+
+  return satResult;
+}
+
+/**
+ * Is one of @b lits true in the current model of _solver?
+ */
+bool FiniteModelBuilder::trueInModel(const SATLiteralStack& lits)
+{
+  for (unsigned i = 0; i < lits.size(); i++) {
+    if (_solver->trueInAssignment(lits[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FiniteModelBuilder::nogoodFromFailedAssumptions(Constraint_Generator_Vals& nogood)
+{
+  ASS(!_xmass);
+
+  // a kept solver of fmb_incremental may involve the markers in conflicts it could find without them
+  // (through clauses learned for previous sizes), which would make the nogood too weak to ever finish
+  const SATLiteralStack& failed = _incremental ? _solver->explicitlyMinimizedFailedAssumptions() : _solver->failedAssumptions();
+
+  nogood.ensure(_distinctSortSizes.size());
+
+  for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+    nogood[i] = make_pair(STAR,_distinctSortSizes[i]);
+  }
+
+  for (unsigned i = 0; i < failed.size(); i++) {
+    unsigned var = failed[i].var();
+
+    if (var >= instancesMarker_offset && var < instancesMarker_offset+_distinctSortSizes.size()) {
+      unsigned dsort = var-instancesMarker_offset;
+      if (nogood[dsort].first == STAR) { // instances used (and we don't know yet about totality)
+        ASS(!_sortedSignature->monotonicSorts[dsort]);
+        nogood[dsort].first = GEQ;
+      }
+      continue;
+    }
+    for (unsigned dsort = 0; dsort < _distinctSortSizes.size(); dsort++) {
+      if (var == totalityMarker(dsort)) { // totality used (-> instances used as well / unless the sort is monotonic)
+        if (_sortedSignature->monotonicSorts[dsort]) {
+          nogood[dsort].first = LEQ;
+        } else {
+          nogood[dsort].first = EQ;
+        }
+        break;
+      }
+    }
+    // otherwise the symmetry selector of fmb_incremental, which says nothing about the sizes
+  }
+}
+
+/**
+ * Messages sent by a worker of runParallel to the parent, each a tag byte followed by the data.
+ * A worker that dies without sending a message (e.g. because it ran out of memory) is noticed by the end of its pipe.
+ */
+enum FmbWorkerMessage : char {
+  // the sizes are too large to be encoded
+  FMB_CANNOT_REPRESENT = 'C',
+  // no model of the sizes, followed by the weight and the signs of the nogood learned
+  FMB_NO_MODEL = 'U',
+  // found a model, the worker waits for the permission to output it
+  FMB_MODEL_FOUND = 'S',
+  // the model was output, followed by whether the SZS status was printed and by the model (see Statistics::model)
+  FMB_MODEL_OUTPUT = 'M',
+};
+
+/** Return false if the other end of the pipe is closed */
+static bool writeToPipe(int fd, const void* data, size_t len)
+{
+  const char* p = static_cast<const char*>(data);
+  while (len) {
+    ssize_t res = ::write(fd, p, len);
+    if (res < 0) {
+      if (errno == EINTR) { continue; }
+      return false;
+    }
+    p += res;
+    len -= res;
+  }
+  return true;
+}
+
+static void pushBytes(Stack<char>& msg, const void* data, size_t len)
+{
+  const char* p = static_cast<const char*>(data);
+  for (size_t i = 0; i < len; i++) {
+    msg.push(p[i]);
+  }
+}
+
+/** Return false if the pipe is closed before @b len bytes are read */
+static bool readFromPipe(int fd, void* data, size_t len)
+{
+  char* p = static_cast<char*>(data);
+  while (len) {
+    ssize_t res = ::read(fd, p, len);
+    if (res < 0 && errno == EINTR) {
+      continue;
+    }
+    if (res <= 0) {
+      return false;
+    }
+    p += res;
+    len -= res;
+  }
+  return true;
+}
+
+/**
+ * Try the sizes _distinctSortSizes in a forked process, see runParallel.
+ * If @b alone is false, the worker shares the memory limit with the other workers.
+ */
+FiniteModelBuilder::FmbWorker FiniteModelBuilder::startWorker(bool alone, unsigned estimate)
+{
+  int toParent[2];
+  int fromParent[2];
+  if (pipe(toParent) || pipe(fromParent)) {
+    SYSTEM_FAIL("Call to pipe() function failed.", errno);
+  }
+  // don't let the child inherit and repeat any pending output
+  cout.flush();
+
+  pid_t pid = Multiprocessing::instance()->fork();
+  if (pid == 0) {
+    close(toParent[0]);
+    close(fromParent[1]);
+    runWorker(toParent[1], fromParent[0], alone);
+  }
+  close(toParent[1]);
+  close(fromParent[0]);
+
+  FmbWorker w;
+  w.pid = pid;
+  w.toParent = toParent[0];
+  w.fromParent = fromParent[1];
+  w.sizes.initFromArray(_distinctSortSizes.size(), _distinctSortSizes);
+  w.alone = alone;
+  w.estimate = estimate;
+  return w;
+}
+
+void FiniteModelBuilder::runWorker(int toParent, int fromParent, bool alone)
+{
+  TIME_TRACE_NEW_ROOT("fmb worker")
+  // the parent enforces the time limit, we just need to die with it
+  System::registerForSIGHUPOnParentDeath();
+
+  if (!alone) {
+    Lib::setMemoryLimit(_opt.memoryLimit() * 1048576ul / _opt.fmbWorkers());
+  }
+
+  // stay silent unless allowed to output a model; e.g. running out of memory is reported by the parent
+  int savedStdout = dup(STDOUT_FILENO);
+  int devNull = open("/dev/null", O_WRONLY);
+  dup2(devNull, STDOUT_FILENO);
+  close(devNull);
+
+  try {
+    for(unsigned s=0;s<_sortedSignature->sorts;s++) {
+      _sortModelSizes[s] = _distinctSortSizes[_sortedSignature->parents[s]];
+    }
+    if (!reset()) {
+      char tag = FMB_CANNOT_REPRESENT;
+      writeToPipe(toParent, &tag, 1);
+      System::terminateImmediately(1);
+    }
+
+    unsigned weight;
+    if (encodeAndSolve(weight) != SATSolver::Status::SATISFIABLE) {
+      Constraint_Generator_Vals nogood;
+      nogoodFromFailedAssumptions(nogood);
+
+      Stack<char> msg;
+      msg.push(FMB_NO_MODEL);
+      pushBytes(msg, &weight, sizeof(weight));
+      for (unsigned i = 0; i < nogood.size(); i++) {
+        msg.push(static_cast<char>(nogood[i].first));
+      }
+      writeToPipe(toParent, msg.begin(), msg.size());
+      System::terminateImmediately(1);
+    }
+
+    char tag = FMB_MODEL_FOUND;
+    writeToPipe(toParent, &tag, 1);
+    // wait for the permission, the parent kills us if another worker was faster
+    if (!readFromPipe(fromParent, &tag, 1)) {
+      System::terminateImmediately(1);
+    }
+
+    dup2(savedStdout, STDOUT_FILENO);
+    onModelFound();
+    cout.flush();
+
+    const std::string& model = env.statistics->model;
+    unsigned len = model.size();
+    Stack<char> msg;
+    msg.push(FMB_MODEL_OUTPUT);
+    msg.push(UIHelper::satisfiableStatusWasAlreadyOutput);
+    pushBytes(msg, &len, sizeof(len));
+    pushBytes(msg, model.data(), len);
+    writeToPipe(toParent, msg.begin(), msg.size());
+    System::terminateImmediately(0);
+  } catch (...) {
+    // the parent only notices that we are gone
+    System::terminateImmediately(1);
+  }
+}
+
+/**
+ * Stop the worker @b w (if it is still running) and wait for it.
+ */
+void FiniteModelBuilder::stopWorker(FmbWorker& w)
+{
+  Multiprocessing::instance()->killNoCheck(w.pid, SIGKILL);
+  int status;
+  while (waitpid(w.pid, &status, 0) == -1 && errno == EINTR) {}
+  close(w.toParent);
+  close(w.fromParent);
+}
+
+void FiniteModelBuilder::stopWorkers(Stack<FmbWorker>& workers)
+{
+  while (workers.isNonEmpty()) {
+    stopWorker(workers.top());
+    workers.pop();
+  }
+}
+
+/**
+ * The main loop for fmb_workers > 1 (not used for the contour strategy).
+ *
+ * The parent enumerates the size assignments as in the sequential loop and each is tried
+ * by one of up to fmb_workers forked workers. A size assignment is excluded from the enumeration
+ * as soon as a worker starts on it, so that the next one can be started before the worker finishes.
+ * The nogoods learned by the workers go to the enumerator of the parent and stop the workers
+ * whose sizes they rule out. The first worker finding a model outputs it and the others are killed.
+ *
+ * Workers share the memory limit. If a worker dies without reporting (most likely out of memory),
+ * its sizes are tried again with the whole memory limit once the other workers have finished,
+ * and so are all the later sizes with at least as many estimated instances.
+ */
+MainLoopResult FiniteModelBuilder::runParallel()
+{
+  unsigned maxWorkers = _opt.fmbWorkers();
+  unsigned distinctSorts = _distinctSortSizes.size();
+
+  Stack<FmbWorker> workers;
+  // sizes of workers which died when sharing memory, to be tried alone
+  Stack<DArray<unsigned>> retries;
+  // the least estimated instance count of the sizes whose worker died when sharing memory
+  unsigned aloneEstimate = UINT_MAX;
+  // _distinctSortSizes already holds the first sizes to try
+  bool first = true;
+
+  Constraint_Generator_Vals nogood(distinctSorts);
+  // a write to a worker which is gone should fail instead of killing us,
+  // the previous handler is restored on return
+  struct SigpipeIgnored {
+    void (*previous)(int) = signal(SIGPIPE,SIG_IGN);
+    ~SigpipeIgnored() { signal(SIGPIPE,previous); }
+  } sigpipeIgnored;
+
+  while (true) {
+    while (workers.size() < maxWorkers && (workers.isEmpty() || !workers.top().alone)) {
+      bool retry = retries.isNonEmpty();
+      if (retry) {
+        _distinctSortSizes.initFromArray(distinctSorts, retries.top());
+      } else if (!first && !_dsaEnumerator->increaseModelSizes(_distinctSortSizes,_distinctSortMaxs)) {
+        break;
+      }
+      unsigned estimate = estimateInstanceCount();
+      bool alone = retry || estimate >= aloneEstimate;
+      if (alone && workers.isNonEmpty()) {
+        // the sizes will be enumerated again once there is enough memory
+        break;
+      }
+
+      if (retry) {
+        retries.pop();
+      } else {
+        // no later sizes should be these, whatever the worker finds out
+        for (unsigned i = 0; i < distinctSorts; i++) {
+          nogood[i] = make_pair(EQ,_distinctSortSizes[i]);
+        }
+        _dsaEnumerator->learnNogood(nogood,estimate);
+        first = false;
+      }
+
+      outputTrying();
+      workers.push(startWorker(alone,estimate));
+      if (alone) {
+        break;
+      }
+    }
+
+    if (workers.isEmpty()) {
+      ASS(retries.isEmpty());
+      if (_dsaEnumerator->isFmbComplete(distinctSorts)) {
+        return MainLoopResult(Statistics::REFUTATION,
+            Clause::empty(NonspecificInferenceMany(InferenceRule::MODEL_NOT_FOUND,_prb.units())));
+      }
+      if(outputAllowed()) {
+        cout << "Cannot enumerate next child to try in an incomplete setup" <<endl;
+      }
+      return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+    }
+
+    // sleep until some worker reports or dies
+    DArray<pollfd> fds(workers.size());
+    for (unsigned i = 0; i < workers.size(); i++) {
+      fds[i].fd = workers[i].toParent;
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+    }
+    if (poll(fds.begin(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SYSTEM_FAIL("Call to poll() function failed.", errno);
+    }
+    unsigned idx = 0;
+    while (!fds[idx].revents) {
+      idx++;
+    }
+    FmbWorker w = workers.swapRemove(idx);
+
+    char tag;
+    if (!readFromPipe(w.toParent, &tag, 1)) {
+      stopWorker(w);
+      if (w.alone) {
+        ASS(workers.isEmpty());
+        if(outputAllowed()) {
+          cout << "% Worker died while trying sizes with the whole memory limit" << endl;
+        }
+        return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+      }
+      aloneEstimate = min(aloneEstimate, w.estimate);
+      retries.push(std::move(w.sizes));
+      continue;
+    }
+
+    switch (tag) {
+      case FMB_NO_MODEL: {
+        unsigned weight;
+        DArray<char> signs(distinctSorts);
+        ALWAYS(readFromPipe(w.toParent, &weight, sizeof(weight)));
+        ALWAYS(readFromPipe(w.toParent, signs.begin(), distinctSorts));
+        stopWorker(w);
+
+        for (unsigned i = 0; i < distinctSorts; i++) {
+          nogood[i] = make_pair(static_cast<ConstraintSign>(signs[i]),w.sizes[i]);
+        }
+#if VTRACE_DOMAINS
+        cout << "Learned a nogood: ";
+        output_cg(nogood);
+        cout << " of weight " << weight << endl;
+#endif
+        _dsaEnumerator->learnNogood(nogood,weight);
+
+        for (unsigned i = 0; i < workers.size(); ) {
+          if (HackyDSAE::checkConstriant(workers[i].sizes,nogood)) {
+            stopWorker(workers[i]);
+            workers.swapRemove(i);
+          } else {
+            i++;
+          }
+        }
+        for (unsigned i = 0; i < retries.size(); ) {
+          if (HackyDSAE::checkConstriant(retries[i],nogood)) {
+            retries.swapRemove(i);
+          } else {
+            i++;
+          }
+        }
+        break;
+      }
+      case FMB_MODEL_FOUND: {
+        stopWorkers(workers);
+        cout.flush();
+        tag = 'y';
+        char szsOutput;
+        unsigned len;
+        if (!writeToPipe(w.fromParent, &tag, 1) || !readFromPipe(w.toParent, &tag, 1) || tag != FMB_MODEL_OUTPUT ||
+            !readFromPipe(w.toParent, &szsOutput, 1) || !readFromPipe(w.toParent, &len, sizeof(len))) {
+          stopWorker(w);
+          return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+        }
+        std::string model(len, ' ');
+        ALWAYS(readFromPipe(w.toParent, model.data(), len));
+        stopWorker(w);
+
+        _distinctSortSizes.initFromArray(distinctSorts, w.sizes);
+        UIHelper::satisfiableStatusWasAlreadyOutput = szsOutput;
+        env.statistics->model = model;
+        return MainLoopResult(Statistics::SATISFIABLE);
+      }
+      default:
+        ASS_EQ(tag, FMB_CANNOT_REPRESENT);
+        stopWorker(w);
+        stopWorkers(workers);
+        if(outputAllowed()){
+          cout << "Cannot represent all propositional literals internally" <<endl;
+        }
+        return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
+    }
+  }
+}
+
 void FiniteModelBuilder::onModelFound()
 {
   // Don't do any output if proof is off
@@ -1897,8 +2496,6 @@ void FiniteModelBuilder::onModelFound()
         << " for " << _opt.problemName() << endl << flush;
     UIHelper::satisfiableStatusWasAlreadyOutput = true;
   }
-  // Prevent timing out whilst the model is being printed
-  Timer::disableLimitEnforcement();
 
   DArray<unsigned> vampireSortSizes;
   vampireSortSizes.ensure(env.signature->typeCons());
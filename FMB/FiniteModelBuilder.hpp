@@ -71,6 +71,8 @@ private:
 
   // Creates the model output
   void onModelFound();
+  // Prints the sizes about to be tried
+  void outputTrying();
 
   // Adds constraints from ground clauses (same constraints for each model size)
   void addGroundClauses();
@@ -120,6 +122,26 @@ private:
 
   // resets all structures and SAT solver using _sortModelSizes 
   bool reset();
+  void createSolver();
+
+  // With fmb_incremental the SAT solver is kept as long as the sizes grow (see resetIncremental)
+  bool _incremental;
+  bool resetIncremental();
+  bool alreadyEncoded(const DArray<unsigned>& grounding, const DArray<unsigned>& sorts);
+  // false if _solver already has the clauses of _encodedSortSizes, to which only the new ones are added
+  bool _freshSolver;
+  DArray<unsigned> _encodedSortSizes;
+  DArray<unsigned> _encodedDistinctSortSizes;
+  // the variables of the grounded symbols, [2*f (function) or 2*p+1 (predicate), grounding...]
+  DHMap<Stack<unsigned>,unsigned> _groundVars;
+  // the totality marker of each distinct sort and whether it is new for the current sizes
+  DArray<unsigned> _totalityMarkers;
+  DArray<bool> _freshTotality;
+  // guards the symmetry axioms of the current sizes
+  unsigned _symmetrySelector;
+  unsigned totalityMarker(unsigned dsort) const {
+    return _incremental ? _totalityMarkers[dsort] : totalityMarker_offset+dsort;
+  }
 
   // make the symmetry orderings
   void createSymmetryOrdering();
@@ -148,8 +170,19 @@ private:
     satClauseLits.push(lit);
     addSATClause(SATClause::fromStack(satClauseLits));
   }
-  // SAT clauses to be added. We record them so we can delete them after calling the SAT solver
+  // Pass the clauses in _clausesToBeAdded to the SAT solver and delete them
+  void flushClauses();
+  // SAT clauses to be added. They are passed to the SAT solver in chunks, so that only a chunk is kept at a time
   SATClauseStack _clausesToBeAdded;
+  static const unsigned CLAUSE_CHUNK_SIZE = 1 << 14;
+  // the number of clauses passed to the SAT solver since reset()
+  unsigned _clausesAdded;
+
+  // Instances of the non-ground clauses are only added when false in the model found (option fmb_lazy_instances)
+  bool _lazyInstances;
+  // addNewInstances adds only the instances false in the current model
+  bool _onlyViolatedInstances;
+  bool trueInModel(const SATLiteralStack& lits);
 
   // The inferred signature of sorts (see SortInference.hpp)
   SortedSignature* _sortedSignature;
@@ -277,10 +310,9 @@ private:
 
     bool _keepOldGenerators;
     Stack<Constraint_Generator*> _old_generators; // keeping old generators degraded performance on average ...
-  protected:
-    bool checkConstriant(DArray<unsigned>& newSortSizes, Constraint_Generator_Vals& constraint);
-
   public:
+    static bool checkConstriant(DArray<unsigned>& newSortSizes, Constraint_Generator_Vals& constraint);
+
     HackyDSAE(bool keepOldGenerators) : _maxWeightSoFar(0), _keepOldGenerators(keepOldGenerators) {}
 
     bool init(unsigned _startSize, DArray<unsigned>&, Stack<std::pair<unsigned,unsigned>>& dsc, Stack<std::pair<unsigned,unsigned>>& sdsc) override {
@@ -315,6 +347,30 @@ private:
   };
 #endif
 
+  // Adds the constraints for the current sizes to the SAT solver prepared by reset() and solves them;
+  // weight is set to the number of clauses added
+  SATSolver::Status encodeAndSolve(unsigned& weight);
+  // Generalises the current sizes after encodeAndSolve failed, using the failed assumptions
+  void nogoodFromFailedAssumptions(Constraint_Generator_Vals& nogood);
+
+  // A forked process of runParallel trying one size assignment
+  struct FmbWorker {
+    pid_t pid;
+    int toParent;
+    int fromParent;
+    DArray<unsigned> sizes;
+    unsigned estimate;
+    // whether the worker has the whole memory limit
+    bool alone;
+  };
+
+  // The main loop with several size assignments tried at a time (option fmb_workers)
+  MainLoopResult runParallel();
+  FmbWorker startWorker(bool alone, unsigned estimate);
+  [[noreturn]] void runWorker(int toParent, int fromParent, bool alone);
+  static void stopWorker(FmbWorker& w);
+  static void stopWorkers(Stack<FmbWorker>& workers);
+
   // the sort constraints from injectivity/surjectivity
   // pairs of distinct sorts where pair.first >= pair.second
   Stack<std::pair<unsigned,unsigned>> _distinct_sort_constraints;
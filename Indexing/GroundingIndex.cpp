@@ -21,8 +21,10 @@
 
 #include "Shell/Options.hpp"
 
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
+#include "SAT/TracingSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -33,7 +35,11 @@ using namespace std;
 
 GroundingIndex::GroundingIndex(const Options& opt)
 {
-  _solver = new MinisatInterfacing(opt,true);
+  if (opt.satSolver() == Options::SatSolver::CDCL) {
+    _solver = TracingSolver::traceIfRequested(new CDCLSolver(opt,true),opt,"gs");
+  } else {
+    _solver = TracingSolver::traceIfRequested(new MinisatInterfacing(opt,true),opt,"gs");
+  }
   _grounder = new Kernel::GlobalSubsumptionGrounder(_solver.ptr());
 }
 
@@ -15,16 +15,21 @@
 #ifndef __Indexing_Index__
 #define __Indexing_Index__
 
+#include <functional>
+
 #include "Forwards.hpp"
 #include "Debug/Output.hpp"
 
 #include "Lib/Event.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/Term.hpp"
+#include "Kernel/CompactTermList.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/VirtualIterator.hpp"
+#include "Lib/Metaiterators.hpp"
 #include "Saturation/ClauseContainer.hpp"
 #include "ResultSubstitution.hpp"
+#include "TermSharing.hpp"
 #include "Kernel/UnificationWithAbstraction.hpp"
 #include "Lib/Allocator.hpp"
 
@@ -40,6 +45,15 @@ using namespace Kernel;
 using namespace Lib;
 using namespace Saturation;
 
+#if VCOMPACT_TERMS
+/** terms in the leaves are stored in 32 bits each, see CompactTermList */
+using LeafTermList = CompactTermList;
+using LeafTypedTermList = CompactTypedTermList;
+#else
+using LeafTermList = TermList;
+using LeafTypedTermList = TypedTermList;
+#endif
+
 struct LiteralClause 
 {
   Literal* const& key() const
@@ -92,14 +106,14 @@ public:
 
 struct TermLiteralClause 
 {
-  TypedTermList term;
+  LeafTypedTermList term;
   Literal* literal = nullptr;
   Clause* clause = nullptr;
 
-  TypedTermList const& key() const { return term; }
+  TypedTermList key() const { return term; }
 
   auto  asTuple() const
-  { return std::make_tuple(clause->number(), literal->getId(), term); }
+  { return std::make_tuple(clause->number(), literal->getId(), key()); }
 
   IMPL_COMPARISONS_FROM_TUPLE(TermLiteralClause)
 
@@ -112,11 +126,13 @@ struct TermLiteralClause
 };
 
 /** Custom leaf data for forward demodulation to store the demodulator
- * left- and right-hand side normalized and cache preorderedness. */
+ * left- and right-hand side normalized and cache preorderedness.
+ * The comparator is owned by the index (see @b OrderingComparatorCache)
+ * and may be shared by several demodulators. */
 struct DemodulatorData
 {
-  DemodulatorData(TypedTermList term, TermList rhs, Clause* clause, bool preordered, const Ordering& ord)
-    : term(term), rhs(rhs), clause(clause), preordered(preordered), comparator(ord.createComparator(term, rhs))
+  DemodulatorData(TypedTermList term, TermList rhs, Clause* clause, bool preordered, OrderingComparator* comparator, const Ordering& ord)
+    : term(term), rhs(rhs), preordered(preordered), clause(clause), comparator(comparator)
   {
 #if VDEBUG
     ASS(term.containsAllVariablesOf(rhs));
@@ -129,16 +145,16 @@ struct DemodulatorData
   }
 
   // lhs, the identifier is required to be `term` by CodeTree
-  TypedTermList term;
-  TermList rhs;
-  Clause* clause;
+  LeafTypedTermList term;
+  LeafTermList rhs;
   bool preordered; // whether term > rhs
-  OrderingComparatorUP comparator; // owned comparator for whether term > rhs
+  Clause* clause;
+  OrderingComparator* comparator; // comparator for whether term > rhs, or nullptr if not needed
 
-  TypedTermList const& key() const { return term; }
+  TypedTermList key() const { return term; }
 
   auto asTuple() const
-  { return std::make_tuple(clause->number(), term, rhs); }
+  { return std::make_tuple(clause->number(), key(), TermList(rhs)); }
 
   IMPL_COMPARISONS_FROM_TUPLE(DemodulatorData)
 
@@ -181,19 +197,49 @@ template<class Unifier, class Data>
 QueryRes<Unifier, Data> queryRes(Unifier unifier, Data const* d) 
 { return QueryRes<Unifier, Data>(std::move(unifier), std::move(d)); }
 
+template<class Data, class = void>
+struct has_clause
+{ static constexpr bool value = false; };
+
+template<class Data>
+struct has_clause<Data, std::void_t<decltype(std::declval<Data>().clause)>>
+{ static constexpr bool value = true; };
+
 class Index
 {
 public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+  /** Number of clauses of the attached container in the index */
+  unsigned clauseCount() const { return _clauseCount; }
+
+  /**
+   * Clauses for which @b filter returns false stay in the index but are not
+   * returned by the queries of @b LiteralIndex and @b TermIndex. Installed by
+   * the IndexManager when deactivated clauses are evicted lazily.
+   */
+  void setRetrievalFilter(std::function<bool(Clause*)> filter) { _retrievalFilter = std::move(filter); }
+
+  template<class Unifier, class Data>
+  VirtualIterator<QueryRes<Unifier, Data>> filterRetrievable(VirtualIterator<QueryRes<Unifier, Data>> it)
+  {
+    if constexpr (has_clause<Data>::value) {
+      if (_retrievalFilter) {
+        return pvi(iterTraits(std::move(it))
+            .filter([this](QueryRes<Unifier, Data> const& qr) { return _retrievalFilter(qr.data->clause); }));
+      }
+    }
+    return it;
+  }
 protected:
-  Index() {}
+  Index() : _clauseCount(0) {}
 
+  // indices may store terms not occurring in the clause (e.g. normalized ones)
   void onAddedToContainer(Clause* c)
-  { handleClause(c, true); }
+  { TermSharing::KeepAliveScope keep(this, c); handleClause(c, true); _clauseCount++; }
   void onRemovedFromContainer(Clause* c)
-  { handleClause(c, false); }
+  { handleClause(c, false); env.sharing->release(this, c); _clauseCount--; }
 
   virtual void handleClause(Clause* c, bool adding) {}
 
@@ -202,6 +248,8 @@ protected:
 private:
   SubscriptionData _addedSD;
   SubscriptionData _removedSD;
+  std::function<bool(Clause*)> _retrievalFilter;
+  unsigned _clauseCount;
 };
 
 };
@@ -18,6 +18,7 @@
 #include "Kernel/Grounder.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
+#include "Saturation/Splitter.hpp"
 
 #include "AcyclicityIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
@@ -82,6 +83,25 @@ Index* IndexManager::get(IndexType t)
   return _store.get(t).index;
 }
 
+/**
+ * Print the number of clauses in each index as a JSON object,
+ * keyed by the IndexType of the index
+ */
+void IndexManager::printClauseCounts(std::ostream& out)
+{
+  out << "{";
+  bool first = true;
+  decltype(_store)::Iterator it(_store);
+  while (it.hasNext()) {
+    IndexType t;
+    Entry e;
+    it.next(t, e);
+    out << (first ? "" : ", ") << "\"" << static_cast<int>(t) << "\": " << e.index->clauseCount();
+    first = false;
+  }
+  out << "}";
+}
+
 /**
  * Provide index form the outside
  *
@@ -233,6 +253,10 @@ Index* IndexManager::create(IndexType t)
   default:
     INVALID_OPERATION("Unsupported IndexType.");
   }
+  if (_alg->getOptions().splittingLazyDeactivation() && _alg->getSplitter()) {
+    Splitter* splitter = _alg->getSplitter();
+    res->setRetrievalFilter([splitter](Clause* cl) { return splitter->isRetrievable(cl); });
+  }
   if(isGenerating) {
     res->attachContainer(_alg->getGeneratingClauseContainer());
   }
@@ -86,6 +86,7 @@ public:
   Index* get(IndexType t);
 
   void provideIndex(IndexType t, Index* index);
+  void printClauseCounts(std::ostream& out);
 private:
 
   struct Entry {
@@ -34,22 +34,22 @@ public:
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getUnifications(Literal *lit, bool complementary, bool retrieveSubstitutions = true)
   {
-    return _is->getUnifications(lit, complementary, retrieveSubstitutions);
+    return filterRetrievable(_is->getUnifications(lit, complementary, retrieveSubstitutions));
   }
 
   VirtualIterator<QueryRes<AbstractingUnifier *, Data>> getUwa(Literal *lit, bool complementary, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
   {
-    return _is->getUwa(lit, complementary, uwa, fixedPointIteration);
+    return filterRetrievable(_is->getUwa(lit, complementary, uwa, fixedPointIteration));
   }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getGeneralizations(Literal *lit, bool complementary, bool retrieveSubstitutions = true)
   {
-    return _is->getGeneralizations(lit, complementary, retrieveSubstitutions);
+    return filterRetrievable(_is->getGeneralizations(lit, complementary, retrieveSubstitutions));
   }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getInstances(Literal *lit, bool complementary, bool retrieveSubstitutions = true)
   {
-    return _is->getInstances(lit, complementary, retrieveSubstitutions);
+    return filterRetrievable(_is->getInstances(lit, complementary, retrieveSubstitutions));
   }
 
   size_t getUnificationCount(Literal *lit, bool complementary)
@@ -136,12 +136,19 @@ void DemodulationLHSIndex::handleClause(Clause* c, bool adding)
     Renaming r;
     r.normalizeVariables(lhs);
 
-    DemodulatorData dd(
-      TypedTermList(r.apply(lhs),r.apply(lhs.sort())),
-      r.apply(EqHelper::getOtherEqualitySide(lit, lhs)),
-      c, preordered, _ord
-    );
+    TypedTermList lhsN(r.apply(lhs),r.apply(lhs.sort()));
+    TermList rhsN = r.apply(EqHelper::getOtherEqualitySide(lit, lhs));
+
+    // only unorientable demodulators are checked with a precompiled comparator
+    bool needsComparator = !preordered && _opt.demodulationPrecompiledComparison();
+    OrderingComparator* comparator = (needsComparator && adding) ? _comparators.acquire(lhsN, rhsN) : nullptr;
+
+    DemodulatorData dd(lhsN, rhsN, c, preordered, comparator, _ord);
     _is->handle(std::move(dd), adding);
+
+    if (needsComparator && !adding) {
+      _comparators.release(lhsN, rhsN);
+    }
   }
 }
 
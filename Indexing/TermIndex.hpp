@@ -21,6 +21,7 @@
 #include "Indexing/TermSubstitutionTree.hpp"
 #include "TermIndexingStructure.hpp"
 #include "Lib/Set.hpp"
+#include "Kernel/OrderingComparatorCache.hpp"
 
 namespace Indexing {
 
@@ -32,16 +33,16 @@ public:
   virtual ~TermIndex() {}
 
   VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
-  { return _is->getUwa(t, uwa, fixedPointIteration); }
+  { return filterRetrievable(_is->getUwa(t, uwa, fixedPointIteration)); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnifications(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getUnifications(t, retrieveSubstitutions); }
+  { return filterRetrievable(_is->getUnifications(t, retrieveSubstitutions)); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getGeneralizations(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getGeneralizations(t, retrieveSubstitutions); }
+  { return filterRetrievable(_is->getGeneralizations(t, retrieveSubstitutions)); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getInstances(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getInstances(t, retrieveSubstitutions); }
+  { return filterRetrievable(_is->getInstances(t, retrieveSubstitutions)); }
 
   friend std::ostream& operator<<(std::ostream& out, TermIndex const& self)
   { return out << *self._is; }
@@ -113,12 +114,14 @@ class DemodulationLHSIndex
 {
 public:
   DemodulationLHSIndex(TermIndexingStructure<DemodulatorData>* is, Ordering& ord, const Options& opt)
-  : TermIndex(is), _ord(ord), _opt(opt) {};
+  : TermIndex(is), _ord(ord), _opt(opt), _comparators(ord, opt.demodulationComparatorCache()) {};
 protected:
   void handleClause(Clause* c, bool adding);
 private:
   Ordering& _ord;
   const Options& _opt;
+  /** comparators of the unorientable demodulators, shared among variants and kept across removals */
+  OrderingComparatorCache _comparators;
 };
 
 /**
@@ -23,8 +23,11 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 #include "Kernel/ApplicativeHelper.hpp"
+#include "Kernel/Clause.hpp"
+#include "Kernel/FormulaUnit.hpp"
 
 #include "Shell/Statistics.hpp"
+#include "Shell/SubexpressionIterator.hpp"
 #include "Debug/TimeProfiling.hpp"
 
 #include "TermSharing.hpp"
@@ -32,6 +35,7 @@
 using namespace std;
 using namespace Kernel;
 using namespace Indexing;
+using namespace Shell;
 
 typedef ApplicativeHelper AH;
 
@@ -41,7 +45,11 @@ typedef ApplicativeHelper AH;
  */
 TermSharing::TermSharing()
   : _poly(true),
-    _wellSortednessCheckingDisabled(false)
+    _wellSortednessCheckingDisabled(false),
+    _lastTermId(0),
+    _lastLiteralId(0),
+    _collectionEnabled(false),
+    _keepAliveScopes(0)
 {
 }
 
@@ -51,6 +59,10 @@ TermSharing::TermSharing()
  */
 TermSharing::~TermSharing()
 {
+  DHMap<std::pair<const void*,Clause*>,Stack<Term*>*>::Iterator pit(_scopePins);
+  while (pit.hasNext()) {
+    delete pit.next();
+  }
 #if CHECK_LEAKS
   Set<Term*,TermSharing>::Iterator ts(_terms);
   while (ts.hasNext()) {
@@ -161,7 +173,8 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
       }
     }
     t->markShared();
-    t->setId(_terms.size());
+    t->setId(++_lastTermId);
+    created(t);
     t->setNumVarOccs(vars);
     t->setWeight(weight);
     t->setHasTermVar(hasTermVar);
@@ -272,7 +285,8 @@ void TermSharing::computeAndSetSharedLiteralData(Literal* t)
       }
     }
     t->markShared();
-    t->setId(_literals.size());
+    t->setId(++_lastLiteralId);
+    created(t);
     t->setNumVarOccs(vars);
     t->setWeight(weight);
     if (env.colorUsed) {
@@ -312,7 +326,8 @@ void TermSharing::computeAndSetSharedVarEqData(Literal* t, TermList sort)
   t->setTwoVarEqSort(sort);
 
     t->markShared();
-    t->setId(_literals.size());
+    t->setId(++_lastLiteralId);
+    created(t);
     // 3 since we have two variables and the equality symbol itself.
     // Additionally, we need sort.weight() in the polymorphic case since
     // the sort may contain variables and Vampire assumes the invariant
@@ -407,3 +422,144 @@ bool TermSharing::equals(const Term* s,const Term* t)
   }
   return true;
 } // TermSharing::equals
+
+TermSharing::KeepAliveScope::KeepAliveScope(const void* owner, Clause* cl)
+  : _owner(owner), _cl(cl), _start(env.sharing->_scopeTerms.size())
+{
+  TermSharing* ts = env.sharing;
+  ts->_keepAliveScopes++;
+  for (Literal* l : cl->iterLits()) {
+    ts->reused(l);
+  }
+}
+
+TermSharing::KeepAliveScope::~KeepAliveScope()
+{
+  TermSharing* ts = env.sharing;
+  ts->_keepAliveScopes--;
+  if (ts->_scopeTerms.size() == _start) {
+    return;
+  }
+  Stack<Term*>** rec;
+  if (ts->_scopePins.getValuePtr(std::make_pair(_owner, _cl), rec, nullptr)) {
+    *rec = new Stack<Term*>();
+  }
+  Stack<Term*>& terms = **rec;
+  for (unsigned i = _start; i < ts->_scopeTerms.size(); i++) {
+    terms.push(ts->_scopeTerms[i]);
+  }
+  ts->_scopeTerms.truncate(_start);
+  // the same terms are typically looked up many times
+  terms.sort();
+  terms.truncate(std::unique(terms.begin(), terms.end()) - terms.begin());
+}
+
+void TermSharing::release(const void* owner, Clause* cl)
+{
+  Stack<Term*>* rec;
+  if (_scopePins.pop(std::make_pair(owner, cl), rec)) {
+    delete rec;
+  }
+}
+
+/**
+ * Mark @b t and the collectable terms below it as reachable.
+ *
+ * Non-shared terms (which occur in formulas) are never collectable
+ * themselves, but their arguments may be.
+ */
+void TermSharing::markReachable(Term* t, DHSet<Term*>& reachable)
+{
+  static Stack<Term*> toDo;
+  ASS(toDo.isEmpty());
+  toDo.push(t);
+  while (toDo.isNonEmpty()) {
+    Term* s = toDo.pop();
+    if (s->shared() && (!_collectable.find(s) || !reachable.insert(s))) {
+      // older terms have only older subterms
+      continue;
+    }
+    for (TermList* ts = s->args(); !ts->isEmpty(); ts = ts->next()) {
+      if (ts->isTerm()) {
+        toDo.push(ts->term());
+      }
+    }
+  }
+}
+
+void TermSharing::markReachable(Unit* u, DHSet<Term*>& reachable)
+{
+  if (u->isClause()) {
+    for (Literal* l : static_cast<Clause*>(u)->iterLits()) {
+      markReachable(l, reachable);
+    }
+    return;
+  }
+  // formulas may contain collectable terms also inside special terms
+  SubexpressionIterator sit(static_cast<FormulaUnit*>(u)->formula());
+  while (sit.hasNext()) {
+    SubexpressionIterator::Expression e = sit.next();
+    if (e.isTerm()) {
+      if (e.getTerm().isTerm()) {
+        markReachable(e.getTerm().term(), reachable);
+      }
+    } else if (e.getFormula()->connective() == LITERAL) {
+      markReachable(e.getFormula()->literal(), reachable);
+    }
+  }
+}
+
+/**
+ * Free the collectable terms and literals that are not reachable from the roots
+ * (see enableCollection()) and return their number.
+ *
+ * Must not be called while terms not referred to from a unit are in use,
+ * i.e. only between inferences.
+ */
+unsigned TermSharing::collectGarbage()
+{
+  TIME_TRACE("term sharing garbage collection");
+  ASS(_collectionEnabled);
+
+  DHSet<Term*> reachable;
+  DHSet<Unit*>::Iterator rit(_roots);
+  while (rit.hasNext()) {
+    markReachable(rit.next(), reachable);
+  }
+  DHSet<Term*>::Iterator pit(_pinned);
+  while (pit.hasNext()) {
+    markReachable(pit.next(), reachable);
+  }
+  DHMap<std::pair<const void*,Clause*>,Stack<Term*>*>::Iterator sit(_scopePins);
+  while (sit.hasNext()) {
+    for (Term* t : *sit.next()) {
+      markReachable(t, reachable);
+    }
+  }
+
+  Stack<Term*> garbage;
+  DHSet<Term*>::Iterator cit(_collectable);
+  while (cit.hasNext()) {
+    Term* t = cit.next();
+    if (!reachable.find(t)) {
+      garbage.push(t);
+    }
+  }
+
+  collectingEvent.fire();
+
+  // remove all from the tables first, the hashes of literals look into their arguments
+  for (Term* t : garbage) {
+    _collectable.remove(t);
+    if (t->isLiteral()) {
+      ALWAYS(_literals.remove(static_cast<Literal*>(t)));
+    } else {
+      ALWAYS(_terms.remove(t));
+    }
+  }
+  for (Term* t : garbage) {
+    t->_args[0]._setShared(false);
+    t->destroy();
+  }
+  return garbage.size();
+} // TermSharing::collectGarbage
@@ -17,10 +17,16 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Event.hpp"
 #include "Lib/Set.hpp"
+#include "Lib/SharingTable.hpp"
+#include "Lib/TermArena.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
 
 using namespace Lib;
 using namespace Kernel;
@@ -92,6 +98,58 @@ public:
   };
   bool isWellSortednessCheckingDisabled() const { return _wellSortednessCheckingDisabled; }
 
+  /** Number of shared terms */
+  unsigned termCount() const { return _terms.size(); }
+  /** Number of shared literals */
+  unsigned literalCount() const { return _literals.size(); }
+
+  /*
+   * Garbage collection of shared terms and literals.
+   *
+   * Only terms and literals created after enableCollection() are collectable,
+   * so everything built during parsing and preprocessing (and held by the
+   * signature, theories, definitions etc.) is never freed. Sorts are never freed.
+   *
+   * The roots are the units created after enableCollection() that are not
+   * destroyed yet, the terms passed to keepAlive() and the terms recorded by
+   * KeepAliveScope objects that were not released yet. Index entries come
+   * from such units. Any other holder of collectable terms must either call
+   * keepAlive() or subscribe to collectingEvent and drop them there.
+   */
+  void enableCollection() { _collectionEnabled = true; }
+  bool collectionEnabled() const { return _collectionEnabled; }
+  /** Number of collectable terms and literals */
+  unsigned collectableCount() const { return _collectable.size(); }
+  void unitCreated(Unit* u) { if (_collectionEnabled) { _roots.insert(u); } }
+  void unitDestroyed(Unit* u) { if (_collectionEnabled) { _roots.remove(u); } }
+  /** Never collect @b t, for terms referred to from outside units */
+  void keepAlive(Term* t) { if (_collectionEnabled && _collectable.find(t)) { _pinned.insert(t); } }
+  /** Called when an existing shared term or literal is looked up */
+  void reused(Term* t) { if (_keepAliveScopes && _collectable.find(t)) { _scopeTerms.push(t); } }
+
+  /**
+   * While an object of this class exists, the literals of the clause and all
+   * terms and literals that are created or looked up are recorded for the owner
+   * and the clause, and they are kept alive until release() is called with them.
+   * To be used around code that stores terms derived from a clause, e.g.
+   * normalized ones in indices.
+   */
+  class KeepAliveScope {
+  public:
+    KeepAliveScope(const void* owner, Clause* cl);
+    ~KeepAliveScope();
+  private:
+    const void* _owner;
+    Clause* _cl;
+    /** the part of _scopeTerms recorded by this scope */
+    unsigned _start;
+  };
+  /** Stop keeping alive what the scopes of @b owner recorded for @b cl */
+  void release(const void* owner, Clause* cl);
+  unsigned collectGarbage();
+  /** Fired by collectGarbage() just before unreachable terms are freed */
+  PlainEvent collectingEvent;
+
 private:
   friend class Kernel::Term;
   friend class Kernel::Literal;
@@ -99,10 +157,30 @@ private:
   int sumRedLengths(TermStack& args);
   static bool argNormGt(TermList t1, TermList t2);
 
+  void created(Term* t)
+  {
+    if (_collectionEnabled) {
+      _collectable.insert(t);
+      if (_keepAliveScopes) {
+        _scopeTerms.push(t);
+      }
+    }
+  }
+  void markReachable(Term* t, DHSet<Term*>& reachable);
+  void markReachable(Unit* u, DHSet<Term*>& reachable);
+
+#if VSHARING_TABLE && VCOMPACT_TERMS
+  template<class Val> using SharingSet = SharingTable<Val,TermSharing,TermArena::Representation<Val>>;
+#elif VSHARING_TABLE
+  template<class Val> using SharingSet = SharingTable<Val,TermSharing>;
+#else
+  template<class Val> using SharingSet = Set<Val,TermSharing>;
+#endif
+
   /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
+  SharingSet<Term*> _terms;
   /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
+  SharingSet<Literal*> _literals;
   /** The set storing all sorts */
   Set<AtomicSort*,TermSharing> _sorts;
   /* Set containing all array sorts. 
@@ -112,6 +190,24 @@ private:
 
   bool _poly;
   bool _wellSortednessCheckingDisabled;
+
+  /** Ids of terms and literals must stay unique also when some are collected */
+  unsigned _lastTermId;
+  unsigned _lastLiteralId;
+
+  bool _collectionEnabled;
+  /** terms and literals created since enableCollection() and not collected yet */
+  DHSet<Term*> _collectable;
+  /** units created since enableCollection() and not destroyed yet */
+  DHSet<Unit*> _roots;
+  /** collectable terms and literals passed to keepAlive() */
+  DHSet<Term*> _pinned;
+  /** collectable terms and literals recorded by KeepAliveScope objects, by owner and clause */
+  DHMap<std::pair<const void*,Clause*>,Stack<Term*>*> _scopePins;
+  /** collectable terms and literals recorded by the existing KeepAliveScope objects */
+  Stack<Term*> _scopeTerms;
+  /** number of existing KeepAliveScope objects */
+  unsigned _keepAliveScopes;
 }; // class TermSharing
 
 
@@ -923,15 +923,15 @@ void InductionClauseIterator::resolveClauses(InductionContext context, Induction
   static TypedTermList ph(getPlaceholderForTerm(context._indTerms,0));
   // lower bound
   if (bound1) {
-    auto lhs = bound1->literal->polarity() ? bound1->term : ph;
-    auto rhs = bound1->literal->polarity() ? ph : bound1->term;
+    auto lhs = bound1->literal->polarity() ? bound1->key() : ph;
+    auto rhs = bound1->literal->polarity() ? ph : bound1->key();
     context.insert(bound1->clause,
       Literal::create2(less, bound1->literal->polarity(), lhs, rhs));
   }
   // upper bound
   if (bound2) {
-    auto lhs = bound2->literal->polarity() ? ph : bound2->term;
-    auto rhs = bound2->literal->polarity() ? bound2->term : ph;
+    auto lhs = bound2->literal->polarity() ? ph : bound2->key();
+    auto rhs = bound2->literal->polarity() ? bound2->key() : ph;
     context.insert(bound2->clause,
       Literal::create2(less, bound2->literal->polarity(), lhs, rhs));
   }
@@ -27,6 +27,8 @@
 #include "Lib/Stack.hpp"
 #include "Lib/BitUtils.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Saturation/ClauseContainer.hpp"
 #include "Saturation/Splitter.hpp"
 
@@ -67,6 +69,7 @@ Clause::Clause(Literal *const *lits, unsigned length, Inference inf)
       _extensionality(false),
       _extensionalityTag(false),
       _component(false),
+      _splitsActive(false),
       _store(NONE),
       _numSelected(0),
       _weight(0),
@@ -75,6 +78,7 @@ Clause::Clause(Literal *const *lits, unsigned length, Inference inf)
       _reductionTimestamp(0),
       _literalPositions(0),
       _numActiveSplits(0),
+      _splitsActiveEpoch(0),
       _auxTimestamp(0)
 {
   // MS: TODO: not sure if this belongs here and whether EXTENSIONALITY_AXIOM input types ever appear anywhere (as a vampire-extension TPTP formula role)
@@ -157,6 +161,7 @@ void Clause::destroyExceptInferenceObject()
   }
 
   ConditionalRedundancyHandler::destroyClauseData(this);
+  env.sharing->unitDestroyed(this);
 
   RSTAT_CTR_INC("clauses deleted");
 
@@ -293,6 +293,22 @@ public:
   void incNumActiveSplits() { _numActiveSplits++; }
   void decNumActiveSplits() { _numActiveSplits--; }
 
+  /** Whether all split levels of the clause were active in the AVATAR model with number @b epoch,
+   * or false if that was not recorded. Used by the Splitter's lazy deactivation. */
+  bool splitsActiveIn(unsigned epoch, bool& active) const
+  {
+    if (_splitsActiveEpoch != epoch) {
+      return false;
+    }
+    active = _splitsActive;
+    return true;
+  }
+  void setSplitsActiveIn(unsigned epoch, bool active)
+  {
+    _splitsActiveEpoch = epoch;
+    _splitsActive = active;
+  }
+
   VirtualIterator<std::string> toSimpleClauseStrings();
 
   void setAux()
@@ -397,6 +413,8 @@ protected:
   unsigned _extensionalityTag : 1;
   /** Clause is a splitting component. */
   unsigned _component : 1;
+  /** for splitting: all split levels were active in model _splitsActiveEpoch */
+  unsigned _splitsActive : 1;
 
   /** storage class */
   Store _store : 3;
@@ -416,6 +434,7 @@ protected:
   InverseLookup<Literal> *_literalPositions;
 
   int _numActiveSplits;
+  unsigned _splitsActiveEpoch;
 
   size_t _auxTimestamp;
   void *_auxData;
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file CompactTermList.hpp
+ * Defines classes CompactTermList and CompactTypedTermList.
+ */
+
+#ifndef __Kernel_CompactTermList__
+#define __Kernel_CompactTermList__
+
+#include <cstdint>
+
+#include "Kernel/Term.hpp"
+#include "Kernel/TypedTermList.hpp"
+
+#include "Lib/TermArena.hpp"
+
+#if VCOMPACT_TERMS
+
+namespace Kernel {
+
+/**
+ * A TermList in 32 bits, for structures that store many of them, such as
+ * the leaves of indices.
+ *
+ * Variables and the empty term list have the same content as in TermList,
+ * a term is stored as its handle in Lib::TermArena, whose two lowest bits
+ * are zero like the tag REF. It converts implicitly to and from TermList,
+ * so where a TermList is expected one can be passed.
+ */
+class CompactTermList
+{
+public:
+  CompactTermList() : _content(FUN) {}
+  CompactTermList(TermList t)
+    : _content(t.isTerm() ? TermArena::handle(t.term()) : static_cast<uint32_t>(t.content()))
+  { ASS(t.isTerm() || t.content() <= UINT32_MAX); }
+
+  operator TermList() const
+  {
+    if (isTerm()) {
+      return TermList(term());
+    }
+    TermList res;
+    res.setContent(_content);
+    return res;
+  }
+
+  TermTag tag() const { return static_cast<TermTag>(_content & 3); }
+  bool isEmpty() const { return tag() == FUN; }
+  bool isVar() const { return tag() == ORD_VAR || tag() == SPEC_VAR; }
+  bool isTerm() const { return tag() == REF; }
+  unsigned var() const { ASS(isVar()); return _content / 4; }
+  Term* term() const { ASS(isTerm()); return static_cast<Term*>(TermArena::pointer(_content)); }
+
+  friend bool operator==(CompactTermList l, CompactTermList r) { return l._content == r._content; }
+  friend bool operator!=(CompactTermList l, CompactTermList r) { return l._content != r._content; }
+
+  friend std::ostream& operator<<(std::ostream& out, CompactTermList const& self)
+  { return out << TermList(self); }
+
+private:
+  uint32_t _content;
+};
+
+/**
+ * A TypedTermList stored as two CompactTermList objects.
+ */
+class CompactTypedTermList
+{
+public:
+  CompactTypedTermList() {}
+  CompactTypedTermList(TypedTermList t) : _term(t), _sort(t.sort()) {}
+  CompactTypedTermList(Term* t) : CompactTypedTermList(TypedTermList(t)) {}
+
+  operator TypedTermList() const { return TypedTermList(_term, _sort); }
+
+  bool isVar() const { return _term.isVar(); }
+  bool isTerm() const { return _term.isTerm(); }
+  unsigned var() const { return _term.var(); }
+  Term* term() const { return _term.term(); }
+  SortId sort() const { return _sort; }
+
+  friend bool operator==(CompactTypedTermList const& l, CompactTypedTermList const& r)
+  { return l._term == r._term && l._sort == r._sort; }
+  friend bool operator!=(CompactTypedTermList const& l, CompactTypedTermList const& r)
+  { return !(l == r); }
+
+  friend std::ostream& operator<<(std::ostream& out, CompactTypedTermList const& self)
+  { return out << TypedTermList(self); }
+
+private:
+  CompactTermList _term;
+  CompactTermList _sort;
+};
+
+} // namespace Kernel
+
+#endif // VCOMPACT_TERMS
+
+#endif // __Kernel_CompactTermList__
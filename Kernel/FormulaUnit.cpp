@@ -14,8 +14,11 @@
  * @since 19/05/2007 Manchester
  */
 
+#include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Formula.hpp"
 #include "FormulaUnit.hpp"
 #include "Inference.hpp"
@@ -35,6 +38,7 @@ using namespace Kernel;
 void FormulaUnit::destroy()
 {
   _inference.destroy(); // decrease counters on parents and release heap allocated things own by _inference
+  env.sharing->unitDestroyed(this);
   delete this;
 } // FormulaUnit::destroy
 
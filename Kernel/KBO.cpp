@@ -18,7 +18,10 @@
 #include "Lib/Comparison.hpp"
 #include "Lib/Set.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 #include <fstream>
 
 #include "KBOComparator.hpp"
@@ -136,6 +139,20 @@ void KBO::State::traverse(AppliedTerm tt)
     recordVariable<coef>(tt.term.var());
     return;
   }
+  if constexpr (varsOnly) {
+    if (tt.term.term()->ground()) {
+      return;
+    }
+  } else {
+    if (_kbo.weightsCached()) {
+      // The weights of shared subterms are stored in their headers by computeWeight,
+      // so the weight is mostly read off directly and only the variables (i.e. the
+      // non-ground subterms) are left to be traversed for the variable balance.
+      _weightDiff += _kbo.computeWeight(tt) * coef;
+      traverse<coef,/*varsOnly=*/true>(tt);
+      return;
+    }
+  }
   struct State {
     AppliedTerm t;
     unsigned arg;
@@ -701,6 +718,10 @@ KBO::KBO(Problem& prb, const Options& opts)
 #endif
  , _state(new State(this))
 {
+  if (opts.kboComparisonCache()) {
+    _cache = make_unique<ComparisonCache>(opts.kboComparisonCache());
+  }
+
   if (opts.kboMaxZero()) {
     zeroWeightForMaximalFunc();
   }
@@ -785,6 +806,16 @@ Ordering::Result KBO::compare(AppliedTerm tl1, AppliedTerm tl2) const
   Term* t1=tl1.term.term();
   Term* t2=tl2.term.term();
 
+  bool useCache = _cache && cacheable(tl1,tl2);
+  if (useCache) {
+    Result res;
+    if (_cache->find(t1,t2,res)) {
+      recordCacheHit(t1,t2);
+      return res;
+    }
+    env.statistics->kboCacheMisses++;
+  }
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -802,6 +833,9 @@ Ordering::Result KBO::compare(AppliedTerm tl1, AppliedTerm tl2) const
 #if VDEBUG
   _state=state;
 #endif
+  if (useCache) {
+    _cache->insert(t1,t2,res);
+  }
   return res;
 }
 
@@ -823,6 +857,17 @@ Ordering::Result KBO::isGreaterOrEq(AppliedTerm tl1, AppliedTerm tl2) const
   Term* t1=tl1.term.term();
   Term* t2=tl2.term.term();
 
+  bool useCache = _cache && cacheable(tl1,tl2);
+  if (useCache) {
+    Result res;
+    if (_cache->find(t1,t2,res)) {
+      recordCacheHit(t1,t2);
+      // only GREATER and EQUAL are reported by the unidirectional check
+      return (res==GREATER || res==EQUAL) ? res : INCOMPARABLE;
+    }
+    env.statistics->kboCacheMisses++;
+  }
+
   auto w1 = computeWeight(tl1);
   auto w2 = computeWeight(tl2);
 
@@ -845,6 +890,9 @@ Ordering::Result KBO::isGreaterOrEq(AppliedTerm tl1, AppliedTerm tl2) const
 #if VDEBUG
     _state=state;
 #endif
+    if (useCache && res==GREATER) {
+      _cache->insert(t1,t2,res);
+    }
     return res;
   }
   // w1==w2
@@ -871,9 +919,52 @@ Ordering::Result KBO::isGreaterOrEq(AppliedTerm tl1, AppliedTerm tl2) const
 #if VDEBUG
   _state=state;
 #endif
+  // INCOMPARABLE may stand for LESS here, so only GREATER is a full comparison result
+  if (useCache && res==GREATER) {
+    _cache->insert(t1,t2,res);
+  }
   return res;
 }
 
+/**
+ * True if the comparison of @b t1 and @b t2 does not depend on a substitution
+ * and both are shared, so that its result can be stored in the comparison cache.
+ */
+bool KBO::cacheable(AppliedTerm t1, AppliedTerm t2) const
+{
+  return (!t1.aboveVar || t1.term.ground()) && (!t2.aboveVar || t2.term.ground())
+    && t1.term.term()->shared() && t2.term.term()->shared();
+}
+
+void KBO::recordCacheHit(Term* t1, Term* t2) const
+{
+  if (t1->ground() && t2->ground()) {
+    env.statistics->kboCacheGroundHits++;
+  } else {
+    env.statistics->kboCacheNonGroundHits++;
+  }
+}
+
+KBO::ComparisonCache::ComparisonCache(unsigned log2Size)
+  : _entries(1u << log2Size), _mask((1u << log2Size) - 1)
+{
+  reset();
+  _collectingSD = env.sharing->collectingEvent.subscribe(this, &ComparisonCache::reset);
+}
+
+KBO::ComparisonCache::~ComparisonCache()
+{
+  _collectingSD->unsubscribe();
+}
+
+void KBO::ComparisonCache::reset()
+{
+  for (unsigned i = 0; i < _entries.size(); i++) {
+    _entries[i].t1 = nullptr;
+    _entries[i].t2 = nullptr;
+  }
+}
+
 bool KBO::isGreater(AppliedTerm lhs, AppliedTerm rhs) const
 {
   return isGreaterOrEq(lhs,rhs)==GREATER;
@@ -898,12 +989,21 @@ int KBO::symbolWeight(const Term* t) const
   return _funcWeights.symbolWeight(t);
 }
 
+/**
+ * True if computeWeight stores the weights of shared terms in their headers,
+ * which is only the case for the global ordering.
+ */
+bool KBO::weightsCached() const
+{
+  return tryGetGlobalOrdering() == this;
+}
+
 unsigned KBO::computeWeight(AppliedTerm tt) const
 {
   if (tt.term.isVar()) {
     return _funcWeights._specialWeights._variableWeight;
   }
-  const bool useCache = (tryGetGlobalOrdering() == this);
+  const bool useCache = weightsCached();
 
   if (!tt.aboveVar && useCache && tt.term.term()->kboWeight(this)!=-1) {
     return tt.term.term()->kboWeight(this);
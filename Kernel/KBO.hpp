@@ -20,6 +20,10 @@
 #include "Forwards.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/Event.hpp"
+#include "Lib/Hash.hpp"
+
+#include "Term.hpp"
 
 #include "Ordering.hpp"
 
@@ -163,6 +167,7 @@ public:
 protected:
   Result isGreaterOrEq(AppliedTerm tt1, AppliedTerm tt2) const;
   unsigned computeWeight(AppliedTerm tt) const;
+  bool weightsCached() const;
 
   Result comparePredicates(Literal* l1, Literal* l2) const override;
 
@@ -266,6 +271,63 @@ private:
    * State used for comparing terms and literals
    */
   mutable State* _state;
+
+  /**
+   * Bounded, direct-mapped cache of comparison results of shared terms.
+   *
+   * As terms are perfectly shared, the result of comparing two shared terms
+   * which are not under a substitution only depends on the two pointers.
+   * Colliding entries simply overwrite each other.
+   */
+  class ComparisonCache
+  {
+  public:
+    ComparisonCache(unsigned log2Size);
+    ~ComparisonCache();
+
+    bool find(Term* t1, Term* t2, Result& res) const
+    {
+      const Entry& e = _entries[index(t1,t2)];
+      if (e.t1 != t1 || e.t2 != t2) {
+        return false;
+      }
+      res = e.res;
+      return true;
+    }
+    void insert(Term* t1, Term* t2, Result res)
+    {
+      Entry& e = _entries[index(t1,t2)];
+      e.t1 = t1;
+      e.t2 = t2;
+      e.res = res;
+    }
+    /** Forget all results, to be called when shared terms may be deallocated */
+    void reset();
+
+  private:
+    unsigned index(Term* t1, Term* t2) const
+    { return HashUtils::combine(t1->getId(), t2->getId()) & _mask; }
+
+    struct Entry {
+      Term* t1;
+      Term* t2;
+      Result res;
+    };
+    DArray<Entry> _entries;
+    unsigned _mask;
+    /** the cache is reset when shared terms are garbage collected */
+    SubscriptionData _collectingSD;
+  };
+
+  bool cacheable(AppliedTerm t1, AppliedTerm t2) const;
+  void recordCacheHit(Term* t1, Term* t2) const;
+
+  /** null if caching of comparisons is disabled */
+  mutable std::unique_ptr<ComparisonCache> _cache;
+
+public:
+  /** Forget all cached comparison results */
+  void resetComparisonCache() const { if (_cache) { _cache->reset(); } }
 };
 
 }
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file OrderingComparatorCache.cpp
+ * Implements class OrderingComparatorCache.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "OrderingComparatorCache.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+OrderingComparatorCache::OrderingComparatorCache(const Ordering& ord, unsigned maxUnused)
+  : _ord(ord), _maxUnused(maxUnused), _unusedCnt(0)
+{
+}
+
+OrderingComparatorCache::~OrderingComparatorCache()
+{
+  decltype(_entries)::Iterator it(_entries);
+  while (it.hasNext()) {
+    delete it.next().comparator;
+  }
+}
+
+OrderingComparator* OrderingComparatorCache::acquire(TermList lhs, TermList rhs)
+{
+  Entry* e;
+  if (_entries.getValuePtr(Key(lhs,rhs), e)) {
+    e->comparator = _ord.createComparator(lhs, rhs).release();
+    e->users = 0;
+    e->queued = false;
+    e->requeue = false;
+    env.statistics->orderingComparatorsCreated++;
+    if (_entries.size() > env.statistics->orderingComparatorCacheMaxSize) {
+      env.statistics->orderingComparatorCacheMaxSize = _entries.size();
+    }
+  } else {
+    if (!e->users) {
+      _unusedCnt--;
+    }
+    env.statistics->orderingComparatorsReused++;
+  }
+  e->users++;
+  return e->comparator;
+}
+
+void OrderingComparatorCache::release(TermList lhs, TermList rhs)
+{
+  Key key(lhs,rhs);
+  Entry* e;
+  ALWAYS(!_entries.getValuePtr(key, e));
+  ASS_G(e->users,0);
+
+  if (--e->users) {
+    return;
+  }
+  if (e->queued) {
+    // it was used again since it was queued, so it is now among the newest
+    e->requeue = true;
+  } else {
+    _unusedQueue.push_back(key);
+    e->queued = true;
+  }
+  _unusedCnt++;
+  evict();
+}
+
+void OrderingComparatorCache::evict()
+{
+  while (_unusedCnt > _maxUnused) {
+    ASS(!_unusedQueue.isEmpty());
+    Key key = _unusedQueue.pop_front();
+    Entry* e = _entries.findPtr(key);
+    ASS(e && e->queued);
+    if (e->users) {
+      // acquired again, it is queued when it loses its last user
+      e->queued = false;
+      e->requeue = false;
+      continue;
+    }
+    if (e->requeue) {
+      e->requeue = false;
+      _unusedQueue.push_back(key);
+      continue;
+    }
+    delete e->comparator;
+    _entries.remove(key);
+    _unusedCnt--;
+    env.statistics->orderingComparatorsEvicted++;
+  }
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file OrderingComparatorCache.hpp
+ * Defines class OrderingComparatorCache.
+ */
+
+#ifndef __OrderingComparatorCache__
+#define __OrderingComparatorCache__
+
+#include "Forwards.hpp"
+
+#include "Lib/Deque.hpp"
+#include "Lib/DHMap.hpp"
+
+#include "Ordering.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * Owns the comparators created by an ordering for oriented equations
+ * @b lhs > @b rhs, so that equal equations share one comparator.
+ *
+ * The equations are expected to be normalized (see @b Renaming), which
+ * makes variants of an equation map to the same comparator.
+ *
+ * Each comparator counts its users. A comparator that has no users left is
+ * kept, so that the instructions it compiled are reused when its equation
+ * comes back, e.g. when a demodulator is re-added after an AVATAR
+ * backtrack. Unused comparators are evicted in the order in which they
+ * lost their last user once there are more than @b maxUnused of them.
+ */
+class OrderingComparatorCache
+{
+public:
+  OrderingComparatorCache(const Ordering& ord, unsigned maxUnused);
+  ~OrderingComparatorCache();
+
+  /** Return the comparator for @b lhs > @b rhs and register a new user of it */
+  OrderingComparator* acquire(TermList lhs, TermList rhs);
+  /** Unregister one user of the comparator for @b lhs > @b rhs */
+  void release(TermList lhs, TermList rhs);
+
+  /** number of comparators in the cache */
+  unsigned size() const { return _entries.size(); }
+  /** number of comparators in the cache without users */
+  unsigned unused() const { return _unusedCnt; }
+
+private:
+  using Key = std::pair<TermList,TermList>;
+
+  struct Entry {
+    OrderingComparator* comparator;
+    unsigned users;
+    /** whether the key is in _unusedQueue */
+    bool queued;
+    /** whether the entry lost its last user again after it was queued */
+    bool requeue;
+  };
+
+  void evict();
+
+  const Ordering& _ord;
+  unsigned _maxUnused;
+  DHMap<Key,Entry> _entries;
+  /**
+   * keys of entries that lost their last user, oldest first; each entry is
+   * queued at most once, entries used again since are requeued or dropped by evict()
+   */
+  Deque<Key> _unusedQueue;
+  unsigned _unusedCnt;
+};
+
+}
+
+#endif // __OrderingComparatorCache__
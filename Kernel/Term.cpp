@@ -18,6 +18,7 @@
 #include "Debug/Output.hpp"
 #include "Indexing/TermSharing.hpp"
 #include "Lib/Metaiterators.hpp"
+#include "Lib/TermArena.hpp"
 
 #include "SubstHelper.hpp"
 #include "TermIterators.hpp"
@@ -52,7 +53,11 @@ void* Term::operator new(size_t,unsigned arity, size_t preData)
   ASS_EQ(preData%sizeof(size_t), 0);
 
   size_t sz = sizeof(Term)+arity*sizeof(TermList)+preData;
+#if VCOMPACT_TERMS
+  void* mem = TermArena::alloc(sz);
+#else
   void* mem = ALLOC_KNOWN(sz,"Term");
+#endif
   mem = reinterpret_cast<void*>(reinterpret_cast<char*>(mem)+preData);
   return (Term*)mem;
 } // Term::operator new
@@ -73,7 +78,11 @@ void Term::destroy ()
   size_t sz = sizeof(Term)+_arity*sizeof(TermList)+getPreDataSize();
   void* mem = this;
   mem = reinterpret_cast<void*>(reinterpret_cast<char*>(mem)-getPreDataSize());
+#if VCOMPACT_TERMS
+  TermArena::free(mem,sz);
+#else
   DEALLOC_KNOWN(mem,sz,"Term");
+#endif
 } // Term::destroy
 
 /**
@@ -855,6 +864,8 @@ Term* Term::create(unsigned function, unsigned arity, const TermList* args)
         created);
     if (created) {
       env.sharing->computeAndSetSharedTermData(shared);
+    } else {
+      env.sharing->reused(shared);
     }
     return shared;
   } else {
@@ -1405,6 +1416,8 @@ Literal* Literal::create(unsigned predicate, unsigned arity, bool polarity, GetA
         env.sharing->computeAndSetSharedVarEqData(shared, *twoVarEqSort);
       else
         env.sharing->computeAndSetSharedLiteralData(shared);
+    } else {
+      env.sharing->reused(shared);
     }
     ASS(predicate != 0 || rightArgOrder(*shared->nthArgument(0), *shared->nthArgument(1)))
     return shared;
@@ -24,6 +24,7 @@
 #include "Lib/DHMap.hpp"
 
 #include "Shell/Statistics.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Inference.hpp"
 #include "InferenceStore.hpp"
@@ -59,6 +60,7 @@ Unit::Unit(Kind kind, Inference inf)
     _inheritedColor(COLOR_INVALID),
     _inference(std::move(inf))
 {
+  env.sharing->unitCreated(this);
 } // Unit::Unit
 
 void Unit::incRefCnt()
@@ -15,6 +15,8 @@
 #ifndef __SharedSet__
 #define __SharedSet__
 
+#include <cstdint>
+
 #include "Forwards.hpp"
 
 #include "Debug/Assertion.hpp"
@@ -36,7 +38,7 @@ class SharedSet {
 public:
   DECL_ELEMENT_TYPE(T);
 
-  SharedSet(size_t sz) : _size(sz) {}
+  SharedSet(size_t sz) : _signature(0), _size(sz) {}
 
   /** Return the size of the set */
   inline unsigned size() const {
@@ -74,6 +76,9 @@ public:
 
   bool member(T val) const
   {
+    if(!(_signature & signatureBit(val))) {
+      return false;
+    }
     size_t l=0;
     size_t r=size();
     while(l<r) {
@@ -104,6 +109,14 @@ public:
       return s;
     }
 
+    // sets are shared, so unions can be remembered by the addresses of the operands
+    UnionCacheEntry& ce = unionCacheEntry(this, s);
+    if(ce.res && ((ce.s1==this && ce.s2==s) || (ce.s1==s && ce.s2==this))) {
+      return ce.res;
+    }
+    ce.s1 = this;
+    ce.s2 = s;
+
     bool p1Superset = true;
     bool p2Superset = true;
 
@@ -147,14 +160,14 @@ public:
 
     ASS(!p1Superset || !p2Superset);
     if(p1Superset) {
-      return this;
+      return ce.res = this;
     }
     if(p2Superset) {
-      return s;
+      return ce.res = s;
     }
 
     const SharedSet* res=create(acc);
-    return res;
+    return ce.res = res;
   }
 
   const SharedSet* getIntersection(const SharedSet* s) const
@@ -164,6 +177,9 @@ public:
     if(s==this) {
       return this;
     }
+    if(!(_signature & s->_signature)) {
+      return getEmpty();
+    }
 
     static ItemStack acc;
     ASS(acc.isEmpty());
@@ -204,6 +220,9 @@ public:
     if(s==this) {
       return getEmpty();
     }
+    if(!(_signature & s->_signature)) {
+      return this;
+    }
 
     static ItemStack acc;
     ASS(acc.isEmpty());
@@ -242,6 +261,10 @@ public:
   {
     ASS(s);
 
+    if(!(_signature & s->_signature)) {
+      return false;
+    }
+
     const T* p1=_items;
     const T* p2=s->_items;
     const T* p1e=p1+size();
@@ -273,6 +296,9 @@ public:
     if(s==this) {
       return true;
     }
+    if(_signature & ~s->_signature) {
+      return false;
+    }
 
     const T* p1=_items;
     const T* p2=s->_items;
@@ -415,9 +441,45 @@ private:
     DEALLOC_KNOWN(obj, size,"SharedSet");
   }
 
+  /**
+   * Bit signatureBit(x) is set for every item x. For sets of small
+   * numbers (e.g. of split levels below 64) this is the set itself,
+   * otherwise it lets most member, subset and intersection tests
+   * finish without looking at the items.
+   */
+  uint64_t _signature;
   size_t _size;
   T _items[1];
 
+  static uint64_t signatureBit(T val)
+  {
+    if constexpr (std::is_pointer<T>::value) {
+      // skip the bits that are zero because of alignment
+      return uint64_t(1) << ((reinterpret_cast<uintptr_t>(val) >> 3) & 63);
+    } else {
+      return uint64_t(1) << (static_cast<uint64_t>(val) & 63);
+    }
+  }
+
+  struct UnionCacheEntry {
+    const SharedSet* s1;
+    const SharedSet* s2;
+    const SharedSet* res;
+  };
+
+  /** Direct-mapped cache of the results of getUnion */
+  static UnionCacheEntry& unionCacheEntry(const SharedSet* s1, const SharedSet* s2)
+  {
+    static constexpr unsigned UNION_CACHE_BITS = 12;
+    static UnionCacheEntry cache[1<<UNION_CACHE_BITS] = {};
+
+    // symmetric, as the union is
+    uintptr_t key = reinterpret_cast<uintptr_t>(s1) ^ reinterpret_cast<uintptr_t>(s2);
+    key ^= key >> UNION_CACHE_BITS;
+    key ^= key >> (2*UNION_CACHE_BITS);
+    return cache[(key >> 3) & ((1<<UNION_CACHE_BITS)-1)];
+  }
+
 
   static bool equals(const T* arr1, const T* arr2, size_t len)
   {
@@ -457,6 +519,7 @@ private:
     for(size_t i=0;i<sz;i++) {
       ASS(i==0 || is[i-1]<is[i]);
       res->_items[i]=is[i];
+      res->_signature |= signatureBit(is[i]);
     }
 
     getSStruct().insert(res);
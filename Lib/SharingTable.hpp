@@ -0,0 +1,289 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file SharingTable.hpp
+ * Defines class SharingTable<Val,Hash>, an open-addressing hash set with
+ * control bytes for the hash-consing of terms.
+ */
+
+#ifndef __SharingTable__
+#define __SharingTable__
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Forwards.hpp"
+
+#include "Allocator.hpp"
+#include "Debug/Assertion.hpp"
+
+namespace Lib {
+
+/** Stores the values of a SharingTable as they are */
+template<typename Val>
+struct PlainRepresentation {
+  using Stored = Val;
+  static Stored pack(Val v) { return v; }
+  static Val unpack(Stored s) { return s; }
+};
+
+/**
+ * A set of values (pointers to shared terms) with the part of the interface
+ * of Set used by TermSharing, laid out for fast lookups in the style of
+ * Swiss tables.
+ *
+ * Besides the slots, which hold a value together with its hash, there is a
+ * control byte for each slot: empty, deleted, or seven bits of the hash of
+ * the value in the slot. A lookup loads a group of 16 control bytes (with SSE2
+ * at once) and only looks at the slots whose control byte matches. Their
+ * stored hash is compared next, so the value is dereferenced only if the whole
+ * hash is equal. Growing the table does not dereference values at all.
+ *
+ * Groups are aligned and probed quadratically. The capacity is a power of two
+ * and a multiple of the group size. Values are compared using
+ * Hash::equals(Val,Key), Hash::hash(Key) gives the hash of a key.
+ *
+ * The slots store values converted by Repr::pack, and Repr::unpack converts
+ * them back, which allows smaller slots, see TermArena::Representation.
+ */
+template <typename Val, class Hash, class Repr = PlainRepresentation<Val>>
+class SharingTable
+{
+public:
+  USE_ALLOCATOR(SharingTable);
+
+  SharingTable()
+    : _capacity(0), _size(0), _used(0), _maxUsed(0), _ctrl(nullptr), _slots(nullptr)
+  {
+    allocate(GROUP_SIZE * 2);
+  }
+
+  ~SharingTable()
+  {
+    deallocate();
+  }
+
+  /** Return the number of values in the table */
+  unsigned size() const { return _size; }
+
+  /**
+   * If the table contains a value equal to @b key, assign it to
+   * @b result and return true
+   */
+  template<typename Key>
+  bool find(Key key, Val& result) const
+  {
+    Slot* slot = lookup(Hash::hash(key), [&](Val v) { return Hash::equals(v, key); });
+    if (!slot) {
+      return false;
+    }
+    result = Repr::unpack(slot->value);
+    return true;
+  }
+
+  /**
+   * Return the value with hash @b hashCode for which @b isCorrectVal holds.
+   * If there is no such value, insert the one returned by @b create and set
+   * @b inserted to true. Like Set::rawFindOrInsert, but returns the value by copy.
+   */
+  template<class Create, class IsCorrectVal>
+  Val rawFindOrInsert(Create create, unsigned hashCode, IsCorrectVal isCorrectVal, bool& inserted)
+  {
+    Slot* found = lookup(hashCode, isCorrectVal);
+    if (found) {
+      inserted = false;
+      return Repr::unpack(found->value);
+    }
+    if (_used >= _maxUsed) {
+      // drop the deleted slots, grow only if they are not many
+      grow(_size >= _maxUsed / 2 ? _capacity * 2 : _capacity);
+    }
+    unsigned pos = freeSlot(hashCode);
+    if (_ctrl[pos] == EMPTY) {
+      _used++;
+    }
+    _size++;
+    setCtrl(pos, h2(hashCode));
+    _slots[pos].code = hashCode;
+    Val val = create();
+    _slots[pos].value = Repr::pack(val);
+    inserted = true;
+    ASS_EQ(Hash::hash(val), hashCode);
+    return val;
+  }
+
+  /** Remove @b val from the table, return true if it was there */
+  bool remove(Val val)
+  {
+    Slot* found = lookup(Hash::hash(val), [&](Val v) { return Hash::equals(v, val); });
+    if (!found) {
+      return false;
+    }
+    setCtrl(found - _slots, DELETED);
+    _size--;
+    return true;
+  }
+
+private:
+  SharingTable(const SharingTable&) = delete;
+  SharingTable& operator=(const SharingTable&) = delete;
+
+  static constexpr unsigned GROUP_SIZE = 16;
+  /** control bytes of full slots are the seven low bits of the hash, so non-negative */
+  static constexpr int8_t EMPTY = -128;
+  static constexpr int8_t DELETED = -2;
+
+  struct Slot {
+    unsigned code;
+    typename Repr::Stored value;
+  };
+
+  static int8_t h2(unsigned hashCode) { return hashCode & 0x7f; }
+  /** the first probed group; h2 is taken from the low bits, so they are not used here */
+  unsigned firstGroup(unsigned hashCode) const { return (hashCode >> 7) * GROUP_SIZE & (_capacity - 1); }
+
+  /** A group of GROUP_SIZE control bytes, the methods return bit masks of the matching positions */
+  class Group {
+  public:
+#if defined(__SSE2__)
+    explicit Group(const int8_t* ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    unsigned match(int8_t h) const
+    { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), _ctrl))); }
+    /** only empty and deleted control bytes are negative */
+    unsigned matchFree() const
+    { return static_cast<unsigned>(_mm_movemask_epi8(_ctrl)); }
+
+  private:
+    __m128i _ctrl;
+#else
+    explicit Group(const int8_t* ctrl) { std::memcpy(_ctrl, ctrl, GROUP_SIZE); }
+
+    unsigned match(int8_t h) const
+    {
+      unsigned res = 0;
+      for (unsigned i = 0; i < GROUP_SIZE; i++) {
+        res |= unsigned(_ctrl[i] == h) << i;
+      }
+      return res;
+    }
+    unsigned matchFree() const
+    {
+      unsigned res = 0;
+      for (unsigned i = 0; i < GROUP_SIZE; i++) {
+        res |= unsigned(_ctrl[i] < 0) << i;
+      }
+      return res;
+    }
+
+  private:
+    int8_t _ctrl[GROUP_SIZE];
+#endif
+  public:
+    unsigned matchEmpty() const { return match(EMPTY); }
+  };
+
+  static unsigned lowestBit(unsigned mask) { return __builtin_ctz(mask); }
+
+  template<class IsCorrectVal>
+  Slot* lookup(unsigned hashCode, IsCorrectVal isCorrectVal) const
+  {
+    int8_t h = h2(hashCode);
+    unsigned group = firstGroup(hashCode);
+    // triangular numbers of groups visit all of them, as their number is a power of two
+    for (unsigned step = GROUP_SIZE;; step += GROUP_SIZE) {
+      Group g(_ctrl + group);
+      for (unsigned mask = g.match(h); mask; mask &= mask - 1) {
+        Slot& slot = _slots[group + lowestBit(mask)];
+        if (slot.code == hashCode && isCorrectVal(Repr::unpack(slot.value))) {
+          return &slot;
+        }
+      }
+      if (g.matchEmpty()) {
+        return nullptr;
+      }
+      group = (group + step) & (_capacity - 1);
+    }
+  }
+
+  /** The first empty or deleted slot on the probe sequence of @b hashCode */
+  unsigned freeSlot(unsigned hashCode) const
+  {
+    unsigned group = firstGroup(hashCode);
+    for (unsigned step = GROUP_SIZE;; step += GROUP_SIZE) {
+      unsigned mask = Group(_ctrl + group).matchFree();
+      if (mask) {
+        return group + lowestBit(mask);
+      }
+      group = (group + step) & (_capacity - 1);
+    }
+  }
+
+  void setCtrl(unsigned pos, int8_t c) { _ctrl[pos] = c; }
+
+  void allocate(unsigned capacity)
+  {
+    ASS_EQ(capacity & (capacity - 1), 0);
+    ASS_EQ(capacity % GROUP_SIZE, 0);
+    _capacity = capacity;
+    // keep one slot in eight free, so that lookups reach an empty control byte soon
+    _maxUsed = capacity - capacity / 8;
+    _ctrl = static_cast<int8_t*>(ALLOC_KNOWN(capacity, "SharingTable::ctrl"));
+    std::memset(_ctrl, EMPTY, capacity);
+    _slots = static_cast<Slot*>(ALLOC_KNOWN(capacity * sizeof(Slot), "SharingTable::Slot"));
+  }
+
+  void deallocate()
+  {
+    DEALLOC_KNOWN(_ctrl, _capacity, "SharingTable::ctrl");
+    DEALLOC_KNOWN(_slots, _capacity * sizeof(Slot), "SharingTable::Slot");
+  }
+
+  /** Move the values to a table of @b capacity slots, the hashes are stored, so no value is looked at */
+  void grow(unsigned capacity)
+  {
+    int8_t* oldCtrl = _ctrl;
+    Slot* oldSlots = _slots;
+    unsigned oldCapacity = _capacity;
+
+    allocate(capacity);
+    for (unsigned i = 0; i < oldCapacity; i++) {
+      if (oldCtrl[i] < 0) {
+        continue;
+      }
+      unsigned pos = freeSlot(oldSlots[i].code);
+      setCtrl(pos, oldCtrl[i]);
+      _slots[pos] = oldSlots[i];
+    }
+    _used = _size;
+
+    DEALLOC_KNOWN(oldCtrl, oldCapacity, "SharingTable::ctrl");
+    DEALLOC_KNOWN(oldSlots, oldCapacity * sizeof(Slot), "SharingTable::Slot");
+  }
+
+  /** number of slots, a power of two */
+  unsigned _capacity;
+  /** number of values */
+  unsigned _size;
+  /** number of slots that are not empty, i.e. full or deleted */
+  unsigned _used;
+  /** the table is rebuilt once this many slots are used */
+  unsigned _maxUsed;
+  int8_t* _ctrl;
+  Slot* _slots;
+}; // class SharingTable
+
+}
+
+#endif // __SharingTable__
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file MappedFile.cpp
+ * Implements class MappedFile.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "MappedFile.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+MappedFile::MappedFile(const std::string& fileName)
+  : _open(false), _data(nullptr), _size(0)
+{
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return;
+  }
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    _size = st.st_size;
+    if (_size == 0) {
+      // mmap refuses empty mappings
+      _open = true;
+    } else {
+      void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        // the input is read once from start to end
+        madvise(data, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(data);
+        _open = true;
+      } else {
+        _size = 0;
+      }
+    }
+  }
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (_data) {
+    munmap(const_cast<char*>(_data), _size);
+  }
+}
+
+}
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file MappedFile.hpp
+ * Defines class MappedFile.
+ */
+
+#ifndef __MappedFile__
+#define __MappedFile__
+
+#include <cstddef>
+#include <string>
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A file mapped read-only into memory, unmapped on destruction.
+ *
+ * Only regular files can be mapped; for anything else (pipes, devices,
+ * files that cannot be opened) isOpen() is false and the caller is
+ * expected to fall back to reading a stream.
+ */
+class MappedFile {
+public:
+  MappedFile(const std::string& fileName);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool isOpen() const { return _open; }
+  /** The first character of the file, may be null for an empty file */
+  const char* begin() const { return _data; }
+  const char* end() const { return _data+_size; }
+  size_t size() const { return _size; }
+
+private:
+  bool _open;
+  const char* _data;
+  size_t _size;
+};
+
+}
+}
+
+#endif // __MappedFile__
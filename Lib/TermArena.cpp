@@ -0,0 +1,109 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file TermArena.cpp
+ * Implements class TermArena.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+
+#include "Allocator.hpp"
+
+#include "TermArena.hpp"
+
+#if VCOMPACT_TERMS
+
+namespace Lib {
+
+char* TermArena::_base = nullptr;
+size_t TermArena::_reserved = 0;
+size_t TermArena::_committed = 0;
+size_t TermArena::_top = 0;
+void** TermArena::_freeLists = nullptr;
+size_t TermArena::_freeListCount = 0;
+
+/**
+ * Reserve the address space of the arena, without any memory behind it.
+ * If the whole MAX_RESERVED bytes cannot be reserved, e.g. because of a limit
+ * on the address space, settle for less.
+ */
+void TermArena::reserve()
+{
+  for (size_t size = MAX_RESERVED; size >= CHUNK; size /= 2) {
+    void* mem = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem != MAP_FAILED) {
+      _base = static_cast<char*>(mem);
+      _reserved = size;
+      return;
+    }
+  }
+  throw std::bad_alloc();
+}
+
+/**
+ * Make sure the first @b top bytes of the arena are committed.
+ * Throws std::bad_alloc if the arena is full or the memory limit is reached.
+ */
+void TermArena::commit(size_t top)
+{
+  if (!_base) {
+    reserve();
+  }
+  if (top <= _committed) {
+    return;
+  }
+  size_t newCommitted = (top + CHUNK - 1) / CHUNK * CHUNK;
+  if (newCommitted > _reserved ||
+      mprotect(_base + _committed, newCommitted - _committed, PROT_READ | PROT_WRITE) != 0) {
+    throw std::bad_alloc();
+  }
+  _committed = newCommitted;
+}
+
+void* TermArena::alloc(size_t size)
+{
+  size_t units = (size + ALIGN - 1) / ALIGN;
+  if (units < _freeListCount && _freeLists[units]) {
+    void** res = static_cast<void**>(_freeLists[units]);
+    _freeLists[units] = *res;
+    return res;
+  }
+  commit(_top + units * ALIGN);
+  void* res = _base + _top;
+  _top += units * ALIGN;
+  return res;
+}
+
+void TermArena::free(void* mem, size_t size)
+{
+  ASS(contains(mem));
+  size_t units = (size + ALIGN - 1) / ALIGN;
+  if (units >= _freeListCount) {
+    size_t newCount = std::max(units + 1, 2 * _freeListCount);
+    void** newLists = static_cast<void**>(Lib::alloc(newCount * sizeof(void*), alignof(void*)));
+    std::memset(newLists, 0, newCount * sizeof(void*));
+    if (_freeLists) {
+      std::memcpy(newLists, _freeLists, _freeListCount * sizeof(void*));
+      Lib::free(_freeLists, _freeListCount * sizeof(void*), alignof(void*));
+    }
+    _freeLists = newLists;
+    _freeListCount = newCount;
+  }
+  *static_cast<void**>(mem) = _freeLists[units];
+  _freeLists[units] = mem;
+}
+
+} // namespace Lib
+
+#endif // VCOMPACT_TERMS
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file TermArena.hpp
+ * Defines class TermArena.
+ */
+
+#ifndef __TermArena__
+#define __TermArena__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Debug/Assertion.hpp"
+
+#if VCOMPACT_TERMS
+
+namespace Lib {
+
+/**
+ * A contiguous region of memory from which all terms and literals are
+ * allocated, so that they can be referred to by 32-bit handles instead of
+ * pointers where many references are stored, see Kernel::CompactTermList.
+ *
+ * The region is reserved at the first allocation and the memory is committed
+ * in chunks as it is needed, so only these count towards the memory limit.
+ * Freed memory is kept in free lists by size. A handle is the offset of an
+ * object divided by two, as all objects are 8-byte aligned this addresses
+ * 8 GB and leaves the two lowest bits of the handle zero.
+ */
+class TermArena
+{
+public:
+  static void* alloc(size_t size);
+  static void free(void* mem, size_t size);
+
+  static bool contains(const void* p)
+  { return p >= _base && p < _base + _top; }
+
+  static uint32_t handle(const void* p)
+  {
+    ASS(contains(p));
+    ASS_EQ(reinterpret_cast<uintptr_t>(p) % ALIGN, 0);
+    return static_cast<uint32_t>((static_cast<const char*>(p) - _base) >> 1);
+  }
+  static void* pointer(uint32_t h)
+  { return _base + (static_cast<size_t>(h) << 1); }
+
+  /** Bytes committed so far */
+  static size_t committed() { return _committed; }
+
+  /**
+   * Stores pointers of type @b Ptr to objects in the arena by their handles,
+   * e.g. in SharingTable
+   */
+  template<class Ptr>
+  struct Representation {
+    using Stored = uint32_t;
+    static Stored pack(Ptr p) { return handle(p); }
+    static Ptr unpack(Stored h) { return static_cast<Ptr>(pointer(h)); }
+  };
+
+private:
+  static constexpr size_t ALIGN = 8;
+  /** the largest region a handle can address */
+  static constexpr size_t MAX_RESERVED = size_t(1) << 33;
+  /** memory is committed in multiples of this */
+  static constexpr size_t CHUNK = size_t(1) << 22;
+
+  static void reserve();
+  static void commit(size_t top);
+
+  static char* _base;
+  static size_t _reserved;
+  static size_t _committed;
+  /** the end of the allocated part */
+  static size_t _top;
+  /**
+   * heads of the free lists, indexed by size in units of ALIGN,
+   * each free block holds a pointer to the next one
+   */
+  static void** _freeLists;
+  static size_t _freeListCount;
+}; // class TermArena
+
+} // namespace Lib
+
+#endif // VCOMPACT_TERMS
+
+#endif // __TermArena__
@@ -18,6 +18,7 @@
 
 #include "Lib/Environment.hpp"
 #include "Lib/NameArray.hpp"
+#include "Lib/ScopedLet.hpp"
 #include "Lib/StringUtils.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/ColorHelper.hpp"
@@ -67,34 +68,81 @@ SMTLIB2::SMTLIB2(UnitList::FIFO formulaBuffer)
   _logic(SMTLIBLogic::UNDEFINED),
   _numeralsAreReal(false),
   _formulas(formulaBuffer),
-  _topLevelExpr(nullptr)
+  _topLevelExpr(nullptr),
+  _lispParser(nullptr),
+  _benchRest(nullptr),
+  _keepTopLevelExpr(false)
 {
 }
 
 void SMTLIB2::parse(istream& str)
 {
   LispLexer lex(str);
+  parse(lex);
+}
+
+void SMTLIB2::parse(const char* begin, const char* end)
+{
+  LispLexer lex(begin,end);
+  parse(lex);
+}
+
+void SMTLIB2::parse(LispLexer& lex)
+{
   LispParser lpar(lex);
-  LExpr* expr = lpar.parse();
-  parse(expr);
+  ScopedLet<LispParser*> parserLet(_lispParser,&lpar);
+  readBenchmark();
+  releaseTopLevelExpr();
 }
 
 void SMTLIB2::parse(LExpr* bench)
 {
   ASS(bench->isList());
-  readBenchmark(bench->list);
+  ScopedLet<LExprList*> benchLet(_benchRest,bench->list);
+  readBenchmark();
 }
 
-void SMTLIB2::readBenchmark(LExprList* bench)
+/**
+ * Make the next top-level expression of the benchmark the current one and return it,
+ * return nullptr at the end of the benchmark.
+ *
+ * When reading the input directly, the expression is parsed just now
+ * and the previous one, unless still needed, is destroyed.
+ */
+LExpr* SMTLIB2::nextTopLevelExpr()
 {
-  LispListReader bRdr(bench);
+  if (_lispParser) {
+    releaseTopLevelExpr();
+    _topLevelExpr = _lispParser->parseNext();
+  } else if (_benchRest) {
+    _topLevelExpr = _benchRest->head();
+    _benchRest = _benchRest->tail();
+  } else {
+    _topLevelExpr = nullptr;
+  }
+  return _topLevelExpr;
+}
 
+/**
+ * Destroy the current top-level expression if it was parsed by _lispParser
+ * and nothing refers to it (see _keepTopLevelExpr).
+ */
+void SMTLIB2::releaseTopLevelExpr()
+{
+  ASS(_lispParser);
+  if (_topLevelExpr && !_keepTopLevelExpr) {
+    _topLevelExpr->destroy();
+  }
+  _topLevelExpr = nullptr;
+  _keepTopLevelExpr = false;
+}
+
+void SMTLIB2::readBenchmark()
+{
   bool afterCheckSat = false;
 
   // iteration over benchmark top level entries
-  while(bRdr.hasNext()) {
-    LExpr* lexp = bRdr.next();
-    _topLevelExpr = lexp;
+  while(LExpr* lexp = nextTopLevelExpr()) {
     _nextVar = 0;
 
     LOG2("readBenchmark ",lexp->toString(true));
@@ -155,6 +203,8 @@ void SMTLIB2::readBenchmark(LExprList* bench)
       LExpr* body = ibRdr.readNext();
 
       readDefineSort(name,args,body);
+      // the definition is parsed only when the sort is used
+      _keepTopLevelExpr = true;
 
       ibRdr.acceptEOL();
 
@@ -360,7 +410,7 @@ void SMTLIB2::readBenchmark(LExprList* bench)
     }
 
     if (ibRdr.tryAcceptAtom("exit")) {
-      bRdr.acceptEOL();
+      acceptEndOfBenchmark();
       break;
     }
 
@@ -403,12 +453,12 @@ void SMTLIB2::readBenchmark(LExprList* bench)
   // however, we want to learn about an unsat core printing request
   // (or other things we might support in the future)
   if (afterCheckSat) {
-    while(bRdr.hasNext()) {
-      LispListReader ibRdr(bRdr.next());
+    while(LExpr* lexp = nextTopLevelExpr()) {
+      LispListReader ibRdr(lexp);
       
       if (ibRdr.tryAcceptAtom("exit")) {
         ibRdr.acceptEOL(); // no arguments of exit
-        bRdr.acceptEOL();  // exit should be the last thing in the file
+        acceptEndOfBenchmark();  // exit should be the last thing in the file
         break;
       }
       
@@ -428,6 +478,13 @@ void SMTLIB2::readBenchmark(LExprList* bench)
   }
 }
 
+void SMTLIB2::acceptEndOfBenchmark()
+{
+  if (nextTopLevelExpr()) {
+    USER_ERROR_EXPR("<eol> expected");
+  }
+}
+
 //  ----------------------------------------------------------------------
 
 #define X(N) #N,
@@ -48,6 +48,8 @@ public:
 
   /** Parse from an open stream */
   void parse(std::istream& str);
+  /** Parse the characters in [begin,end), e.g. of a Lib::Sys::MappedFile */
+  void parse(const char* begin, const char* end);
   /** Parse a ready lisp expression */
   void parse(LExpr* bench);
 
@@ -518,10 +520,31 @@ private:
    */
   LExpr* _topLevelExpr;
 
+  /**
+   * When parsing the input directly, the parser of the top-level expressions.
+   * They are read, processed and destroyed one by one, so the whole benchmark
+   * is never in memory as a lisp expression.
+   */
+  LispParser* _lispParser;
+  /**
+   * When parsing a ready lisp expression, the top-level expressions not read yet.
+   */
+  LExprList* _benchRest;
+  /**
+   * True if something (e.g. a sort definition) refers to the current top-level expression,
+   * so it must not be destroyed after processing.
+   */
+  bool _keepTopLevelExpr;
+
+  void parse(LispLexer& lex);
+  LExpr* nextTopLevelExpr();
+  void releaseTopLevelExpr();
+  void acceptEndOfBenchmark();
+
   /**
    * Toplevel parsing dispatch for a benchmark.
    */
-  void readBenchmark(LExprList* bench);
+  void readBenchmark();
 };
 
 }
@@ -45,6 +45,8 @@ using namespace Kernel;
 using namespace Shell;
 using namespace Parse;
 
+using Lib::Sys::MappedFile;
+
 #define DEBUG_SHOW_TOKENS 0
 #define DEBUG_SHOW_UNITS 0
 #define DEBUG_SOURCE 0
@@ -95,6 +97,30 @@ TPTP::TPTP(istream& in, UnitList::FIFO unitBuffer)
   : _containsConjecture(false),
     _allowedNames(0),
     _in(&in),
+    _mem(nullptr),
+    _memEnd(nullptr),
+    _mappedFile(nullptr),
+    _includeDirectory(""),
+    _units(unitBuffer),
+    _isThf(false),
+    _containsPolymorphism(false),
+    _currentColor(COLOR_TRANSPARENT),
+    _lastPushed(TM),
+    _modelDefinition(false),
+    _insideEqualityArgument(0),
+    _unitSources(0),
+    _filterReserved(false),
+    _seenConjecture(false)
+{
+} // TPTP::TPTP
+
+TPTP::TPTP(const char* begin, const char* end, UnitList::FIFO unitBuffer)
+  : _containsConjecture(false),
+    _allowedNames(0),
+    _in(nullptr),
+    _mem(begin),
+    _memEnd(end),
+    _mappedFile(nullptr),
     _includeDirectory(""),
     _units(unitBuffer),
     _isThf(false),
@@ -110,11 +136,18 @@ TPTP::TPTP(istream& in, UnitList::FIFO unitBuffer)
 } // TPTP::TPTP
 
 /**
- * The destructor, does nothing.
+ * The destructor, closes the included files still open after a parsing error.
  * @since 09/07/2012 Manchester
  */
 TPTP::~TPTP()
 {
+  while (_inputs.isNonEmpty()) {
+    delete _in;
+    delete _mappedFile;
+    Input prev = _inputs.pop();
+    _in = prev.in;
+    _mappedFile = prev.mappedFile;
+  }
 } // TPTP::~TPTP
 
 void TPTP::parse()
@@ -743,8 +776,7 @@ void TPTP::skipWhiteSpacesAndComments()
 #if VDEBUG
         // Only check for Status if in preamble before any units read (also only in the top level file, not in includes)
         if(_units.list() == 0 && _inputs.isEmpty()){
-          _chars[n]='\0';
-          std::string cline(_chars.content());
+          std::string cline(chars(),n);
           if(cline.find("Status")!=std::string::npos){
              if(cline.find("Theorem")!=std::string::npos){ UIHelper::setExpectingUnsat(); }
              else if(cline.find("Unsatisfiable")!=std::string::npos){ UIHelper::setExpectingUnsat(); }
@@ -867,8 +899,8 @@ void TPTP::readName(Token& tok)
     case '9':
       break;
     default:
-      ASS(_chars.content()[0] != '$');
-      tok.content.assign(_chars.content(),n);
+      ASS(chars()[0] != '$');
+      tok.content.assign(chars(),n);
       shiftChars(n);
       return;
     }
@@ -950,7 +982,7 @@ void TPTP::readReserved(Token& tok)
     case '9':
       break;
     default:
-      tok.content.assign(_chars.content(),n);
+      tok.content.assign(chars(),n);
       //shiftChars(n);
       goto out;
     }
@@ -1022,7 +1054,7 @@ void TPTP::readReserved(Token& tok)
           for(;;c++){ if(getChar(c)!='$') break;}
           shiftChars(c);
           n=n-c;
-          tok.content.assign(_chars.content(),n);
+          tok.content.assign(chars(),n);
       }
       
       tok.tag = T_NAME;
@@ -1050,7 +1082,7 @@ void TPTP::readString(Token& tok)
       continue;
     }
     if (c == '"') {
-      tok.content.assign(_chars.content()+1,n-1);
+      tok.content.assign(chars()+1,n-1);
       resetChars();
       return;
     }
@@ -1076,7 +1108,7 @@ void TPTP::readAtom(Token& tok)
       continue;
     }
     if (c == '\'') {
-      tok.content.assign(_chars.content()+1,n-1);
+      tok.content.assign(chars()+1,n-1);
       resetChars();
       return;
     }
@@ -1116,7 +1148,7 @@ TPTP::Tag TPTP::readNumber(Token& tok)
   switch (getChar(pos)) {
   case '/':
     pos = positiveDecimal(pos+1);
-    tok.content.assign(_chars.content(),pos);
+    tok.content.assign(chars(),pos);
     shiftChars(pos);
     return T_RAT;
   case 'E':
@@ -1124,7 +1156,7 @@ TPTP::Tag TPTP::readNumber(Token& tok)
     {
       char c = getChar(pos+1);
       pos = decimal((c == '+' || c == '-') ? pos+2 : pos+1);
-      tok.content.assign(_chars.content(),pos);
+      tok.content.assign(chars(),pos);
       shiftChars(pos);
     }
     return T_REAL;
@@ -1144,12 +1176,12 @@ TPTP::Tag TPTP::readNumber(Token& tok)
         c = getChar(pos+1);
         pos = decimal((c == '+' || c == '-') ? pos+2 : pos+1);
       }
-      tok.content.assign(_chars.content(),pos);
+      tok.content.assign(chars(),pos);
       shiftChars(pos);
     }
     return T_REAL;
   default:
-    tok.content.assign(_chars.content(),pos);
+    tok.content.assign(chars(),pos);
     shiftChars(pos);
     return T_INT;
   }
@@ -1232,7 +1264,12 @@ void TPTP::unitList()
     }
     resetChars();
     delete _in;
-    _in = _inputs.pop();
+    delete _mappedFile;
+    Input prev = _inputs.pop();
+    _in = prev.in;
+    _mem = prev.mem;
+    _memEnd = prev.memEnd;
+    _mappedFile = prev.mappedFile;
     _includeDirectory = _includeDirectories.pop();
     delete _allowedNames;
     _allowedNames = _allowedNamesStack.pop();
@@ -2082,8 +2119,6 @@ void TPTP::include()
   if (!ignore) {
     _allowedNamesStack.push(_allowedNames);
     _allowedNames = 0;
-    _inputs.push(_in);
-    _includeDirectories.push(_includeDirectory);
   }
 
   tok = getTok(0);
@@ -2119,8 +2154,20 @@ void TPTP::include()
   }
   // here should be a computation of the new include directory according to
   // the TPTP standard, so far we just set it to ""
+  _inputs.push(Input{_in, _mem, _memEnd, _mappedFile});
+  _includeDirectories.push(_includeDirectory);
   _includeDirectory = "";
   std::string fileName(env.options->includeFileName(relativeName));
+  // included axiom files can be large, they are lexed directly from a mapping if possible
+  _mappedFile = new MappedFile(fileName);
+  if (_mappedFile->isOpen()) {
+    _in = nullptr;
+    _mem = _mappedFile->begin();
+    _memEnd = _mappedFile->end();
+    return;
+  }
+  delete _mappedFile;
+  _mappedFile = nullptr;
   _in = new ifstream(fileName.c_str());
   if (!*_in) {
     USER_ERROR((std::string)"cannot open file " + fileName);
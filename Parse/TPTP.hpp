@@ -25,6 +25,7 @@
 #include "Lib/Stack.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/IntNameTable.hpp"
+#include "Lib/Sys/MappedFile.hpp"
 
 #include "Kernel/Formula.hpp"
 #include "Kernel/Unit.hpp"
@@ -330,6 +331,12 @@ public:
    *   from multiple parser calls)
    */
   TPTP(std::istream& in, UnitList::FIFO unitBuffer = UnitList::FIFO());
+  /**
+   * @brief Construct a new TPTP parser reading the characters from [begin,end) in memory,
+   *   e.g. from a Lib::Sys::MappedFile. The characters are not copied and must stay
+   *   in place while the parser exists.
+   */
+  TPTP(const char* begin, const char* end, UnitList::FIFO unitBuffer = UnitList::FIFO());
   ~TPTP();
   void parse();
   static UnitList* parse(std::istream& str);
@@ -359,7 +366,7 @@ public:
 private:
   void parseImpl(State initialState = State::UNIT_LIST);
   /** Return the input string of characters */
-  const char* input() { return _chars.content(); }
+  const char* input() { return chars(); }
 
   enum TypeTag {
     TT_ATOMIC,
@@ -534,10 +541,22 @@ private:
   Stack<Set<std::string>*> _allowedNamesStack;
   /** set of files whose inclusion should be ignored */
   Set<std::string> _forbiddenIncludes;
-  /** the input stream */
+  /** the input stream, null when the input is read from memory */
   std::istream* _in;
-  /** in the case include() is used, previous streams will be saved here */
-  Stack<std::istream*> _inputs;
+  /** when reading from memory, the character at the position _gpos */
+  const char* _mem;
+  /** when reading from memory, the position beyond the last character */
+  const char* _memEnd;
+  /** the file mapped by include(), if the current input is one */
+  Lib::Sys::MappedFile* _mappedFile;
+  struct Input {
+    std::istream* in;
+    const char* mem;
+    const char* memEnd;
+    Lib::Sys::MappedFile* mappedFile;
+  };
+  /** in the case include() is used, previous inputs will be saved here */
+  Stack<Input> _inputs;
   /** the current include directory */
   std::string _includeDirectory;
   /** in the case include() is used, previous sequence of directories will be
@@ -545,7 +564,7 @@ private:
    * relative to the "current directory, that is, the directory used by the last include()
    */
   Stack<std::string> _includeDirectories;
-  /** input characters */
+  /** input characters, when reading from a stream */
   Array<char> _chars;
   /** position in the input stream of the 0th character in _chars[] */
   int _gpos;
@@ -653,6 +672,13 @@ private:
    */
   inline char getChar(int pos)
   {
+    if (!_in) {
+      // the characters are already in memory, nothing to copy
+      if (_cend <= pos) {
+        _cend = pos+1;
+      }
+      return pos < _memEnd-_mem ? _mem[pos] : 0;
+    }
     while (_cend <= pos) {
       int c = _in->get();
       //      if (c == -1) { std::cout << "<EOF>"; } else {std::cout << char(c);}
@@ -669,8 +695,12 @@ private:
     ASS(n > 0);
     ASS(n <= _cend);
 
-    for (int i = 0;i < _cend-n;i++) {
-      _chars[i] = _chars[n+i];
+    if (!_in) {
+      skipMem(n);
+    } else {
+      for (int i = 0;i < _cend-n;i++) {
+        _chars[i] = _chars[n+i];
+      }
     }
     _cend -= n;
     _gpos += n;
@@ -682,10 +712,25 @@ private:
    */
   inline void resetChars()
   {
+    if (!_in) {
+      skipMem(_cend);
+    }
     _gpos += _cend;
     _cend = 0;
   } // resetChars
 
+  /** Move the in-memory input by n characters, but not beyond its end */
+  inline void skipMem(int n)
+  {
+    _mem += std::min<ptrdiff_t>(n, _memEnd-_mem);
+  }
+
+  /** The characters starting at the position 0 */
+  inline const char* chars()
+  {
+    return _in ? _chars.content() : _mem;
+  }
+
   /**
    * Get the token at the position pos.
    */
@@ -0,0 +1,961 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file CDCLSolver.cpp
+ * Implements class CDCLSolver.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Lib/Allocator.hpp"
+
+#include "SATClause.hpp"
+
+#include "CDCLSolver.hpp"
+
+namespace SAT
+{
+
+using namespace Lib;
+
+/** conflicts of the first restart, multiplied by the Luby sequence afterwards */
+static const unsigned RESTART_UNIT = 100;
+/** conflicts between two reductions of learnt clauses (grows by REDUCE_INC) */
+static const unsigned REDUCE_BASE = 2000;
+static const unsigned REDUCE_INC = 300;
+/** learnt clauses with at most this many levels are never reduced */
+static const unsigned GLUE_LBD = 2;
+/** conflicts between two rounds of inprocessing */
+static const unsigned INPROCESSING_INTERVAL = 5000;
+/** learnt clauses with at most this many levels are vivified */
+static const unsigned VIVIFY_LBD = 8;
+/** minimal propagation budget of vivification; otherwise a tenth of the search propagations */
+static const size_t VIVIFY_MIN_BUDGET = 10000;
+
+static const double VAR_DECAY = 0.95;
+static const float CLAUSE_DECAY = 0.999f;
+
+/**
+ * The Luby sequence 1,1,2,1,1,2,4,1,1,2,1,1,2,4,8,...
+ * (see also Minisat's Solver.cc)
+ */
+static unsigned luby(unsigned x)
+{
+  unsigned size, seq;
+  for (size = 1, seq = 0; size < x+1; seq++, size = 2*size+1) {}
+  while (size-1 != x) {
+    size = (size-1)>>1;
+    seq--;
+    x = x % size;
+  }
+  return 1u << seq;
+}
+
+CDCLSolver::Clause* CDCLSolver::Clause::create(const Lit* lits, unsigned size, bool learnt)
+{
+  ASS_G(size,1);
+
+  size_t bytes = sizeof(Clause) + (size-1)*sizeof(Lit);
+  Clause* c = static_cast<Clause*>(ALLOC_KNOWN(bytes, "CDCLSolver::Clause"));
+  c->capacity = size;
+  c->size = size;
+  c->lbd = size;
+  c->learnt = learnt;
+  c->vivified = false;
+  c->removed = false;
+  c->activity = 0;
+  std::copy(lits, lits+size, c->lits);
+  return c;
+}
+
+void CDCLSolver::Clause::destroy()
+{
+  DEALLOC_KNOWN(this, sizeof(Clause) + (capacity-1)*sizeof(Lit), "CDCLSolver::Clause");
+}
+
+void CDCLSolver::VarOrder::insert(unsigned v)
+{
+  ASS(!contains(v));
+  while (_pos.size() <= v) {
+    _pos.push(-1);
+  }
+  _pos[v] = _heap.size();
+  _heap.push(v);
+  up(_pos[v]);
+}
+
+unsigned CDCLSolver::VarOrder::popMax()
+{
+  ASS(!isEmpty());
+  unsigned res = _heap[0];
+  unsigned last = _heap.pop();
+  _pos[res] = -1;
+  if (_heap.isNonEmpty()) {
+    _heap[0] = last;
+    _pos[last] = 0;
+    down(0);
+  }
+  return res;
+}
+
+void CDCLSolver::VarOrder::up(unsigned i)
+{
+  unsigned v = _heap[i];
+  while (i > 0) {
+    unsigned parent = (i-1)/2;
+    if (!better(v, _heap[parent])) {
+      break;
+    }
+    _heap[i] = _heap[parent];
+    _pos[_heap[i]] = i;
+    i = parent;
+  }
+  _heap[i] = v;
+  _pos[v] = i;
+}
+
+void CDCLSolver::VarOrder::down(unsigned i)
+{
+  unsigned v = _heap[i];
+  for (;;) {
+    unsigned child = 2*i+1;
+    if (child >= _heap.size()) {
+      break;
+    }
+    if (child+1 < _heap.size() && better(_heap[child+1], _heap[child])) {
+      child++;
+    }
+    if (!better(_heap[child], v)) {
+      break;
+    }
+    _heap[i] = _heap[child];
+    _pos[_heap[i]] = i;
+    i = child;
+  }
+  _heap[i] = v;
+  _pos[v] = i;
+}
+
+CDCLSolver::CDCLSolver(const Shell::Options& opts, bool generateProofs)
+  : _unsat(false), _status(Status::SATISFIABLE), _varCnt(0), _order(_activity),
+    _varInc(1), _clauseInc(1), _qhead(0), _levelStamp(0),
+    _conflicts(0), _propagations(0), _conflictBudgetEnd(SIZE_MAX),
+    _nextReduce(REDUCE_BASE), _reduceCnt(0),
+    _nextInprocessing(INPROCESSING_INTERVAL), _propagationsAtInprocessing(0),
+    _simplifiedTrailSize(0)
+{
+  // slots of the unused variable 0
+  _values.push(VAL_UNDEF);
+  _values.push(VAL_UNDEF);
+  _watches.push(Stack<Watch>());
+  _watches.push(Stack<Watch>());
+  _levels.push(0);
+  _reasons.push(nullptr);
+  _phases.push(false);
+  _activity.push(0);
+  _seen.push(false);
+  _levelStamps.push(0);
+  _touched.push(false);
+  _changed.push(false);
+}
+
+CDCLSolver::~CDCLSolver()
+{
+  collectGarbage();
+  for (Clause* c : _clauses) {
+    c->destroy();
+  }
+  for (Clause* c : _learnts) {
+    c->destroy();
+  }
+}
+
+void CDCLSolver::ensureVarCount(unsigned newVarCnt)
+{
+  while (_varCnt < newVarCnt) {
+    newVar();
+  }
+}
+
+unsigned CDCLSolver::newVar()
+{
+  unsigned v = ++_varCnt;
+  _values.push(VAL_UNDEF);
+  _values.push(VAL_UNDEF);
+  _watches.push(Stack<Watch>());
+  _watches.push(Stack<Watch>());
+  _levels.push(0);
+  _reasons.push(nullptr);
+  // like Minisat, prefer the negative phase initially
+  _phases.push(false);
+  _activity.push(0);
+  _seen.push(false);
+  _levelStamps.push(0);
+  _touched.push(false);
+  _changed.push(false);
+  _order.insert(v);
+  return v;
+}
+
+void CDCLSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+  _phases[var] = pol;
+}
+
+void CDCLSolver::addAssumption(SATLiteral lit)
+{
+  _assumptions.push(toLit(lit));
+}
+
+void CDCLSolver::retractAllAssumptions()
+{
+  _assumptions.reset();
+  _status = Status::UNKNOWN;
+}
+
+void CDCLSolver::addClause(SATClause* cl)
+{
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  ASS(_assumptions.isEmpty());
+  ASS_EQ(decisionLevel(),0);
+
+  if (_unsat) {
+    return;
+  }
+
+  _learnt.reset();
+  for (SATLiteral l : cl->iter()) {
+    ASS_LE(l.var(),_varCnt);
+    Lit lit = toLit(l);
+    if (value(lit) == VAL_TRUE) {
+      return; // satisfied at the root
+    }
+    if (value(lit) == VAL_FALSE) {
+      continue;
+    }
+    _learnt.push(lit);
+  }
+
+  if (_learnt.isEmpty()) {
+    _unsat = true;
+  } else if (_learnt.size() == 1) {
+    assign(_learnt[0], nullptr);
+    _unsat = propagate() != nullptr;
+  } else {
+    Clause* c = Clause::create(_learnt.begin(), _learnt.size(), false);
+    _clauses.push(c);
+    attach(c);
+  }
+}
+
+void CDCLSolver::attach(Clause* c)
+{
+  ASS_GE(c->size,2);
+  _watches[c->lits[0]].push(Watch{ c, c->lits[1] });
+  _watches[c->lits[1]].push(Watch{ c, c->lits[0] });
+}
+
+void CDCLSolver::detach(Clause* c)
+{
+  for (unsigned i = 0; i < 2; i++) {
+    Stack<Watch>& ws = _watches[c->lits[i]];
+    for (unsigned j = 0; j < ws.size(); j++) {
+      if (ws[j].clause == c) {
+        ws[j] = ws.top();
+        ws.pop();
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * Mark @b c as removed; it is deallocated by the next collectGarbage.
+ * The caller takes care of removing it from _clauses or _learnts.
+ */
+void CDCLSolver::removeClause(Clause* c)
+{
+  ASS(!c->removed);
+  c->removed = true;
+  _garbage.push(c);
+}
+
+/**
+ * Drop the watches of removed clauses and deallocate them.
+ */
+void CDCLSolver::collectGarbage()
+{
+  if (_garbage.isEmpty()) {
+    return;
+  }
+  for (Stack<Watch>& ws : _watches) {
+    unsigned j = 0;
+    for (unsigned i = 0; i < ws.size(); i++) {
+      if (!ws[i].clause->removed) {
+        ws[j++] = ws[i];
+      }
+    }
+    ws.truncate(j);
+  }
+  for (Clause* c : _garbage) {
+    c->destroy();
+  }
+  _garbage.reset();
+}
+
+void CDCLSolver::assign(Lit l, Clause* reason)
+{
+  ASS_EQ(value(l),VAL_UNDEF);
+  unsigned v = var(l);
+  _values[l] = VAL_TRUE;
+  _values[l^1] = VAL_FALSE;
+  _levels[v] = decisionLevel();
+  _reasons[v] = reason;
+  _trail.push(l);
+
+  if (v < _model.size() && _model[v] != ((l&1) ? VAL_FALSE : VAL_TRUE) && !_touched[v]) {
+    _touched[v] = true;
+    _touchedVars.push(v);
+  }
+}
+
+/**
+ * Unit propagation with two watched literals. The implied literal of
+ * a reason clause is always its first literal.
+ */
+CDCLSolver::Clause* CDCLSolver::propagate()
+{
+  Clause* confl = nullptr;
+  while (_qhead < _trail.size()) {
+    Lit falseLit = _trail[_qhead++]^1;
+    _propagations++;
+
+    Stack<Watch>& ws = _watches[falseLit];
+    unsigned i = 0, j = 0, n = ws.size();
+    while (i < n) {
+      Watch w = ws[i++];
+      if (value(w.blocker) == VAL_TRUE) {
+        ws[j++] = w;
+        continue;
+      }
+      Clause* c = w.clause;
+      Lit* lits = c->lits;
+      if (lits[0] == falseLit) {
+        lits[0] = lits[1];
+        lits[1] = falseLit;
+      }
+      ASS_EQ(lits[1],falseLit);
+
+      Lit first = lits[0];
+      Watch nw{ c, first };
+      if (first != w.blocker && value(first) == VAL_TRUE) {
+        ws[j++] = nw;
+        continue;
+      }
+
+      bool moved = false;
+      for (unsigned k = 2; k < c->size; k++) {
+        if (value(lits[k]) != VAL_FALSE) {
+          lits[1] = lits[k];
+          lits[k] = falseLit;
+          _watches[lits[1]].push(nw);
+          moved = true;
+          break;
+        }
+      }
+      if (moved) {
+        continue;
+      }
+
+      ws[j++] = nw;
+      if (value(first) == VAL_FALSE) {
+        confl = c;
+        _qhead = _trail.size();
+        while (i < n) {
+          ws[j++] = ws[i++];
+        }
+      } else {
+        assign(first, c);
+      }
+    }
+    ws.truncate(j);
+    if (confl) {
+      break;
+    }
+  }
+  return confl;
+}
+
+void CDCLSolver::backtrack(unsigned level)
+{
+  if (decisionLevel() <= level) {
+    return;
+  }
+  unsigned lim = _trailLim[level];
+  for (unsigned i = _trail.size(); i-- > lim; ) {
+    Lit l = _trail[i];
+    unsigned v = var(l);
+    _values[l] = VAL_UNDEF;
+    _values[l^1] = VAL_UNDEF;
+    _reasons[v] = nullptr;
+    // phase saving
+    _phases[v] = !(l&1);
+    if (!_order.contains(v)) {
+      _order.insert(v);
+    }
+  }
+  _trail.truncate(lim);
+  _trailLim.truncate(level);
+  _qhead = lim;
+}
+
+void CDCLSolver::bumpVar(unsigned v)
+{
+  if ((_activity[v] += _varInc) > 1e100) {
+    for (unsigned i = 1; i <= _varCnt; i++) {
+      _activity[i] *= 1e-100;
+    }
+    _varInc *= 1e-100;
+  }
+  _order.increased(v);
+}
+
+void CDCLSolver::bumpClause(Clause* c)
+{
+  if ((c->activity += _clauseInc) > 1e20f) {
+    for (Clause* l : _learnts) {
+      l->activity *= 1e-20f;
+    }
+    _clauseInc *= 1e-20f;
+  }
+}
+
+/**
+ * First-UIP conflict analysis. The learnt clause is left in _learnt with
+ * the asserting literal first and a literal of level @b btLevel second.
+ */
+void CDCLSolver::analyze(Clause* confl, unsigned& btLevel, unsigned& lbd)
+{
+  _learnt.reset();
+  _learnt.push(NO_LIT); // room for the asserting literal
+
+  int pathCnt = 0;
+  Lit p = NO_LIT;
+  unsigned index = _trail.size();
+
+  do {
+    ASS(confl);
+    if (confl->learnt) {
+      bumpClause(confl);
+    }
+    for (unsigned k = (p == NO_LIT) ? 0 : 1; k < confl->size; k++) {
+      Lit q = confl->lits[k];
+      unsigned v = var(q);
+      if (!_seen[v] && _levels[v] > 0) {
+        bumpVar(v);
+        _seen[v] = true;
+        if (_levels[v] >= decisionLevel()) {
+          pathCnt++;
+        } else {
+          _learnt.push(q);
+        }
+      }
+    }
+    // the next literal of the current level to resolve on
+    while (!_seen[var(_trail[--index])]) {}
+    p = _trail[index];
+    confl = _reasons[var(p)];
+    _seen[var(p)] = false;
+    pathCnt--;
+  } while (pathCnt > 0);
+  _learnt[0] = p^1;
+
+  // drop literals implied by the other ones
+  _toClear.reset();
+  unsigned j = 1;
+  for (unsigned i = 1; i < _learnt.size(); i++) {
+    _toClear.push(var(_learnt[i]));
+    if (!isRedundant(_learnt[i])) {
+      _learnt[j++] = _learnt[i];
+    }
+  }
+  _learnt.truncate(j);
+  for (unsigned v : _toClear) {
+    _seen[v] = false;
+  }
+
+  btLevel = 0;
+  if (_learnt.size() > 1) {
+    unsigned maxI = 1;
+    for (unsigned i = 2; i < _learnt.size(); i++) {
+      if (_levels[var(_learnt[i])] > _levels[var(_learnt[maxI])]) {
+        maxI = i;
+      }
+    }
+    std::swap(_learnt[1], _learnt[maxI]);
+    btLevel = _levels[var(_learnt[1])];
+  }
+
+  _levelStamp++;
+  lbd = 0;
+  for (Lit l : _learnt) {
+    unsigned lev = _levels[var(l)];
+    if (_levelStamps[lev] != _levelStamp) {
+      _levelStamps[lev] = _levelStamp;
+      lbd++;
+    }
+  }
+}
+
+/**
+ * A literal of the learnt clause is redundant if all the other literals of
+ * its reason are in the learnt clause or fixed at the root.
+ */
+bool CDCLSolver::isRedundant(Lit l)
+{
+  Clause* reason = _reasons[var(l)];
+  if (!reason) {
+    return false;
+  }
+  for (unsigned k = 1; k < reason->size; k++) {
+    unsigned v = var(reason->lits[k]);
+    if (!_seen[v] && _levels[v] > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Collect in _failed the assumptions that imply the negation of the
+ * assumption @b failedAssumption.
+ */
+void CDCLSolver::analyzeFinal(Lit failedAssumption)
+{
+  _failed.reset();
+  _failed.push(failedAssumption);
+  if (decisionLevel() == 0) {
+    return;
+  }
+
+  _seen[var(failedAssumption)] = true;
+  for (unsigned i = _trail.size(); i-- > _trailLim[0]; ) {
+    unsigned v = var(_trail[i]);
+    if (!_seen[v]) {
+      continue;
+    }
+    Clause* reason = _reasons[v];
+    if (!reason) {
+      // below the assumption levels, all decisions are assumptions
+      ASS_G(_levels[v],0);
+      _failed.push(_trail[i]);
+    } else {
+      for (unsigned k = 1; k < reason->size; k++) {
+        unsigned u = var(reason->lits[k]);
+        if (_levels[u] > 0) {
+          _seen[u] = true;
+        }
+      }
+    }
+    _seen[v] = false;
+  }
+  _seen[var(failedAssumption)] = false;
+}
+
+CDCLSolver::Lit CDCLSolver::pickBranchLit()
+{
+  while (!_order.isEmpty()) {
+    unsigned v = _order.popMax();
+    if (value(2*v) == VAL_UNDEF) {
+      return 2*v + (_phases[v] ? 0 : 1);
+    }
+  }
+  return NO_LIT;
+}
+
+/**
+ * Keep the learnt clauses with few levels and the more active half of the rest.
+ */
+void CDCLSolver::reduceLearnts()
+{
+  std::sort(_learnts.begin(), _learnts.end(), [](Clause* c1, Clause* c2) {
+    return c1->lbd != c2->lbd ? c1->lbd < c2->lbd : c1->activity > c2->activity;
+  });
+
+  unsigned keep = _learnts.size()/2;
+  unsigned j = 0;
+  for (unsigned i = 0; i < _learnts.size(); i++) {
+    Clause* c = _learnts[i];
+    if (i >= keep && c->lbd > GLUE_LBD && !locked(c)) {
+      removeClause(c);
+    } else {
+      _learnts[j++] = c;
+    }
+  }
+  _learnts.truncate(j);
+  collectGarbage();
+}
+
+CDCLSolver::SearchResult CDCLSolver::search(unsigned restartConflicts)
+{
+  unsigned conflictCnt = 0;
+  for (;;) {
+    Clause* confl = propagate();
+    if (confl) {
+      _conflicts++;
+      conflictCnt++;
+      if (decisionLevel() == 0) {
+        _unsat = true;
+        return SearchResult::UNSAT;
+      }
+
+      unsigned btLevel, lbd;
+      analyze(confl, btLevel, lbd);
+      backtrack(btLevel);
+
+      if (_learnt.size() == 1) {
+        assign(_learnt[0], nullptr);
+      } else {
+        Clause* c = Clause::create(_learnt.begin(), _learnt.size(), true);
+        c->lbd = lbd;
+        _learnts.push(c);
+        attach(c);
+        bumpClause(c);
+        assign(_learnt[0], c);
+      }
+
+      _varInc /= VAR_DECAY;
+      _clauseInc /= CLAUSE_DECAY;
+      continue;
+    }
+
+    // don't consider the budget while still loading assumptions (as in our Minisat)
+    if (conflictCnt >= restartConflicts ||
+        (decisionLevel() >= _assumptions.size() && !withinBudget())) {
+      backtrack(0);
+      return SearchResult::UNDEF;
+    }
+
+    if (decisionLevel() == 0 && _trail.size() > _simplifiedTrailSize) {
+      removeSatisfied(_clauses);
+      removeSatisfied(_learnts);
+      collectGarbage();
+      _simplifiedTrailSize = _trail.size();
+    }
+
+    if (_conflicts >= _nextReduce) {
+      _nextReduce = _conflicts + REDUCE_BASE + REDUCE_INC * ++_reduceCnt;
+      reduceLearnts();
+    }
+
+    Lit next = NO_LIT;
+    while (decisionLevel() < _assumptions.size()) {
+      Lit a = _assumptions[decisionLevel()];
+      if (value(a) == VAL_TRUE) {
+        // dummy decision level
+        newDecisionLevel();
+      } else if (value(a) == VAL_FALSE) {
+        analyzeFinal(a);
+        return SearchResult::UNSAT;
+      } else {
+        next = a;
+        break;
+      }
+    }
+
+    if (next == NO_LIT) {
+      next = pickBranchLit();
+      if (next == NO_LIT) {
+        return SearchResult::SAT;
+      }
+    }
+    newDecisionLevel();
+    assign(next, nullptr);
+  }
+}
+
+SATSolver::Status CDCLSolver::solve(unsigned conflictCountLimit)
+{
+  ASS_EQ(decisionLevel(),0);
+  _failed.reset();
+
+  if (!_unsat && _conflicts >= _nextInprocessing) {
+    inprocess();
+  }
+  if (_unsat) {
+    return _status = Status::UNSATISFIABLE;
+  }
+
+  _conflictBudgetEnd = conflictCountLimit == UINT_MAX ? SIZE_MAX : _conflicts + conflictCountLimit;
+
+  SearchResult res = SearchResult::UNDEF;
+  for (unsigned restarts = 0; res == SearchResult::UNDEF; restarts++) {
+    res = search(luby(restarts) * RESTART_UNIT);
+    if (!withinBudget()) {
+      break;
+    }
+  }
+
+  switch (res) {
+    case SearchResult::SAT:
+      updateModel();
+      _status = Status::SATISFIABLE;
+      break;
+    case SearchResult::UNSAT:
+      _status = Status::UNSATISFIABLE;
+      break;
+    case SearchResult::UNDEF:
+      _status = Status::UNKNOWN;
+      break;
+  }
+  backtrack(0);
+  return _status;
+}
+
+/**
+ * Store the current total assignment as the model. Only the touched
+ * variables and the variables new since the last model need to be looked at.
+ */
+void CDCLSolver::updateModel()
+{
+  for (unsigned v : _touchedVars) {
+    _touched[v] = false;
+    if (_model[v] != value(2*v)) {
+      _model[v] = value(2*v);
+      if (!_changed[v]) {
+        _changed[v] = true;
+        _changedVars.push(v);
+      }
+    }
+  }
+  _touchedVars.reset();
+
+  if (_model.isEmpty()) {
+    _model.push(VAL_UNDEF); // var 0
+  }
+  while (_model.size() <= _varCnt) {
+    unsigned v = _model.size();
+    _model.push(value(2*v));
+    if (!_changed[v]) {
+      _changed[v] = true;
+      _changedVars.push(v);
+    }
+  }
+}
+
+bool CDCLSolver::collectChangedVars(Stack<unsigned>& acc)
+{
+  for (unsigned v : _changedVars) {
+    _changed[v] = false;
+    acc.push(v);
+  }
+  _changedVars.reset();
+  return true;
+}
+
+SATSolver::Status CDCLSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  ASS(!hasAssumptions());
+
+  for (SATLiteral l : assumps) {
+    _assumptions.push(toLit(l));
+  }
+
+  solve(conflictCountLimit);
+
+  if (_status == Status::UNSATISFIABLE) {
+    _failedAssumptionBuffer.reset();
+    for (Lit l : _failed) {
+      _failedAssumptionBuffer.push(toSATLiteral(l));
+    }
+  }
+
+  _assumptions.reset();
+  return _status;
+}
+
+SATSolver::VarAssignment CDCLSolver::getAssignment(unsigned var)
+{
+  ASS_EQ(_status, Status::SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if (var >= _model.size()) {
+    // new vars have been added but the model didn't grow yet
+    return VarAssignment::DONT_CARE;
+  }
+  ASS_NEQ(_model[var],VAL_UNDEF);
+  return _model[var] == VAL_TRUE ? VarAssignment::TRUE : VarAssignment::FALSE;
+}
+
+bool CDCLSolver::isZeroImplied(unsigned var)
+{
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+  // between calls, only the root level is assigned
+  return value(2*var) != VAL_UNDEF;
+}
+
+void CDCLSolver::collectZeroImplied(SATLiteralStack& acc)
+{
+  ASS_EQ(decisionLevel(),0);
+  for (Lit l : _trail) {
+    acc.push(toSATLiteral(l));
+  }
+}
+
+void CDCLSolver::simplify()
+{
+  ASS_EQ(decisionLevel(),0);
+  if (!_unsat) {
+    inprocess();
+  }
+}
+
+/**
+ * Remove the clauses satisfied at the root level.
+ */
+void CDCLSolver::removeSatisfied(Stack<Clause*>& clauses)
+{
+  ASS_EQ(decisionLevel(),0);
+
+  // root level reasons are never looked at, and may be removed below
+  for (Lit l : _trail) {
+    _reasons[var(l)] = nullptr;
+  }
+
+  unsigned j = 0;
+  for (unsigned i = 0; i < clauses.size(); i++) {
+    Clause* c = clauses[i];
+    bool satisfied = false;
+    for (unsigned k = 0; k < c->size; k++) {
+      if (value(c->lits[k]) == VAL_TRUE) {
+        satisfied = true;
+        break;
+      }
+    }
+    if (satisfied) {
+      removeClause(c);
+    } else {
+      clauses[j++] = c;
+    }
+  }
+  clauses.truncate(j);
+}
+
+/**
+ * Root level simplification followed by vivification of the learnt
+ * clauses with few levels that have not been vivified yet.
+ */
+void CDCLSolver::inprocess()
+{
+  ASS_EQ(decisionLevel(),0);
+  ASS(!_unsat);
+
+  size_t budget = std::max(VIVIFY_MIN_BUDGET, (_propagations - _propagationsAtInprocessing) / 10);
+  _nextInprocessing = _conflicts + INPROCESSING_INTERVAL;
+
+  if (propagate()) {
+    _unsat = true;
+    return;
+  }
+  removeSatisfied(_clauses);
+  removeSatisfied(_learnts);
+  collectGarbage();
+
+  // most active first
+  Stack<Clause*> candidates;
+  for (Clause* c : _learnts) {
+    if (!c->vivified && c->lbd <= VIVIFY_LBD) {
+      candidates.push(c);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](Clause* c1, Clause* c2) {
+    return c1->activity > c2->activity;
+  });
+
+  size_t budgetEnd = _propagations + budget;
+  for (Clause* c : candidates) {
+    if (_propagations >= budgetEnd || _unsat) {
+      break;
+    }
+    if (!c->removed) {
+      vivify(c);
+    }
+  }
+
+  unsigned j = 0;
+  for (unsigned i = 0; i < _learnts.size(); i++) {
+    if (!_learnts[i]->removed) {
+      _learnts[j++] = _learnts[i];
+    }
+  }
+  _learnts.truncate(j);
+  collectGarbage();
+
+  _simplifiedTrailSize = _trail.size();
+  _propagationsAtInprocessing = _propagations;
+}
+
+/**
+ * Try to shorten @b c by assuming the negation of its literals one by one:
+ * - a literal that becomes false can be dropped;
+ * - once a literal becomes true, or propagation fails,
+ *   the literals assumed so far (with the true one) suffice.
+ */
+void CDCLSolver::vivify(Clause* c)
+{
+  ASS_EQ(decisionLevel(),0);
+  c->vivified = true;
+  detach(c);
+
+  unsigned newSize = 0;
+  bool satisfied = false;
+  for (unsigned k = 0; k < c->size; k++) {
+    Lit l = c->lits[k];
+    if (value(l) == VAL_TRUE) {
+      if (_levels[var(l)] == 0) {
+        satisfied = true;
+      } else {
+        c->lits[newSize++] = l;
+      }
+      break;
+    }
+    if (value(l) == VAL_FALSE) {
+      continue;
+    }
+    c->lits[newSize++] = l;
+    newDecisionLevel();
+    assign(l^1, nullptr);
+    if (propagate()) {
+      break;
+    }
+  }
+  backtrack(0);
+
+  if (satisfied) {
+    removeClause(c);
+    return;
+  }
+  ASS_G(newSize,0);
+  if (newSize == 1) {
+    removeClause(c);
+    assign(c->lits[0], nullptr);
+    _unsat = propagate() != nullptr;
+    return;
+  }
+  c->size = newSize;
+  c->lbd = std::min<unsigned>(c->lbd, newSize);
+  attach(c);
+}
+
+}
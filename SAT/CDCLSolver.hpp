@@ -0,0 +1,232 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file CDCLSolver.hpp
+ * Defines class CDCLSolver.
+ */
+
+#ifndef __CDCLSolver__
+#define __CDCLSolver__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "SATSolver.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+/**
+ * A conflict-driven clause learning solver for the way Vampire uses SAT
+ * solvers: many small incremental calls, often under assumptions, with
+ * clauses added between the calls.
+ *
+ * - Saved phases, variable activities and learnt clauses survive between
+ *   calls, so consecutive models tend to stay close to each other.
+ * - Every few thousand conflicts, at the start of a call, the clause
+ *   database is simplified at the root level and learnt clauses are
+ *   shortened by vivification, with a budget proportional to the
+ *   propagation work done in search since the last time.
+ * - Failed assumptions are extracted from the final conflict.
+ *
+ * As with MinisatInterfacing, refutations have all the added clauses as
+ * premises.
+ */
+class CDCLSolver : public PrimitiveProofRecordingSATSolver
+{
+public:
+  CDCLSolver(const Shell::Options& opts, bool generateProofs=false);
+  ~CDCLSolver() override;
+
+  /**
+   * Can be called only when all assumptions are retracted
+   *
+   * A requirement is that in a clause, each variable occurs at most once.
+   */
+  void addClause(SATClause* cl) override;
+
+  /**
+   * Simplify the clause database at the root level and vivify learnt clauses.
+   */
+  void simplify() override;
+
+  Status solve(unsigned conflictCountLimit) override;
+
+  VarAssignment getAssignment(unsigned var) override;
+  bool isZeroImplied(unsigned var) override;
+  void collectZeroImplied(SATLiteralStack& acc) override;
+  /** Not supported, as by MinisatInterfacing */
+  SATClause* getZeroImpliedCertificate(unsigned var) override { return 0; }
+  bool collectChangedVars(Stack<unsigned>& acc) override;
+
+  void ensureVarCount(unsigned newVarCnt) override;
+  unsigned newVar() override;
+
+  void suggestPolarity(unsigned var, unsigned pol) override;
+
+  void addAssumption(SATLiteral lit) override;
+  void retractAllAssumptions() override;
+  bool hasAssumptions() const override { return _assumptions.isNonEmpty(); }
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+private:
+  /** 2*var for the positive and 2*var+1 for the negative literal of var */
+  typedef unsigned Lit;
+  static const Lit NO_LIT = 0; // var 0 is not used
+
+  static Lit toLit(SATLiteral l) { return 2*l.var() + (l.isNegative() ? 1 : 0); }
+  static SATLiteral toSATLiteral(Lit l) { return SATLiteral(l>>1, (l&1) ? 0 : 1); }
+  static unsigned var(Lit l) { return l>>1; }
+
+  enum : signed char { VAL_FALSE = -1, VAL_UNDEF = 0, VAL_TRUE = 1 };
+
+  struct Clause {
+    static Clause* create(const Lit* lits, unsigned size, bool learnt);
+    void destroy();
+
+    unsigned capacity;
+    unsigned size;
+    unsigned lbd : 29;
+    unsigned learnt : 1;
+    unsigned vivified : 1;
+    unsigned removed : 1;
+    float activity;
+    Lit lits[1];
+  };
+
+  struct Watch {
+    Clause* clause;
+    /** another literal of the clause; if true, the clause need not be visited */
+    Lit blocker;
+  };
+
+  /** max-heap of variables ordered by activity */
+  class VarOrder {
+  public:
+    VarOrder(const Stack<double>& activity) : _activity(activity) {}
+
+    bool contains(unsigned v) const { return v < _pos.size() && _pos[v] >= 0; }
+    void insert(unsigned v);
+    void increased(unsigned v) { if (contains(v)) { up(_pos[v]); } }
+    bool isEmpty() const { return _heap.isEmpty(); }
+    unsigned popMax();
+
+  private:
+    bool better(unsigned v1, unsigned v2) const { return _activity[v1] > _activity[v2]; }
+    void up(unsigned i);
+    void down(unsigned i);
+
+    const Stack<double>& _activity;
+    Stack<unsigned> _heap;
+    Stack<int> _pos;
+  };
+
+  signed char value(Lit l) const { return _values[l]; }
+  unsigned decisionLevel() const { return _trailLim.size(); }
+  void newDecisionLevel() { _trailLim.push(_trail.size()); }
+
+  void assign(Lit l, Clause* reason);
+  void updateModel();
+  Clause* propagate();
+  void backtrack(unsigned level);
+
+  enum class SearchResult { SAT, UNSAT, UNDEF };
+  SearchResult search(unsigned restartConflicts);
+  bool withinBudget() const { return _conflicts < _conflictBudgetEnd; }
+  Lit pickBranchLit();
+
+  void analyze(Clause* confl, unsigned& btLevel, unsigned& lbd);
+  bool isRedundant(Lit l);
+  void analyzeFinal(Lit failedAssumption);
+
+  void attach(Clause* c);
+  void detach(Clause* c);
+  bool locked(Clause* c) const { return _reasons[var(c->lits[0])] == c && value(c->lits[0]) == VAL_TRUE; }
+  void removeClause(Clause* c);
+  void collectGarbage();
+
+  void bumpVar(unsigned v);
+  void bumpClause(Clause* c);
+  void reduceLearnts();
+
+  void inprocess();
+  void removeSatisfied(Stack<Clause*>& clauses);
+  void vivify(Clause* c);
+
+  /** true once the clauses are unsatisfiable without assumptions */
+  bool _unsat;
+  Status _status;
+
+  unsigned _varCnt;
+  /** indexed by Lit */
+  Stack<signed char> _values;
+  /** indexed by Lit, clauses watching the literal, visited when it becomes false */
+  Stack<Stack<Watch>> _watches;
+  /** indexed by var */
+  Stack<unsigned> _levels;
+  Stack<Clause*> _reasons;
+  /** saved phase: true for positive */
+  Stack<bool> _phases;
+  Stack<double> _activity;
+  Stack<bool> _seen;
+  /** the model of the last satisfiable call, indexed by var */
+  Stack<signed char> _model;
+  /**
+   * Variables assigned, since the last satisfiable call, the opposite of their value in _model.
+   * Only these can have a different value in the next model.
+   */
+  Stack<unsigned> _touchedVars;
+  Stack<bool> _touched;
+  /** variables whose value in _model changed since the last collectChangedVars */
+  Stack<unsigned> _changedVars;
+  Stack<bool> _changed;
+
+  VarOrder _order;
+  double _varInc;
+  float _clauseInc;
+
+  Stack<Lit> _trail;
+  Stack<unsigned> _trailLim;
+  unsigned _qhead;
+
+  Stack<Clause*> _clauses;
+  Stack<Clause*> _learnts;
+  /** removed clauses that may still be referenced from watch lists */
+  Stack<Clause*> _garbage;
+
+  Stack<Lit> _assumptions;
+  /** assumptions responsible for the last unsatisfiable result */
+  Stack<Lit> _failed;
+
+  /** scratch space of analyze */
+  Stack<Lit> _learnt;
+  Stack<unsigned> _toClear;
+  Stack<unsigned> _levelStamps;
+  unsigned _levelStamp;
+
+  size_t _conflicts;
+  size_t _propagations;
+  size_t _conflictBudgetEnd;
+  size_t _nextReduce;
+  unsigned _reduceCnt;
+  size_t _nextInprocessing;
+  size_t _propagationsAtInprocessing;
+  /** trail size at the last removal of satisfied clauses */
+  unsigned _simplifiedTrailSize;
+};
+
+}
+
+#endif // __CDCLSolver__
@@ -50,6 +50,14 @@ public:
     _solver.simplify();
   }
 
+  /**
+   * Keep all the variables in the first call to solve, which otherwise eliminates some of them.
+   * Needed when clauses over the existing variables are added after a solve.
+   */
+  void disableVariableElimination() {
+    _solver.use_elim = false;
+  }
+
   virtual Status solve(unsigned conflictCountLimit) override;
   
   /**
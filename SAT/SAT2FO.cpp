@@ -12,6 +12,10 @@
  * Implements class SAT2FO.
  */
 
+#include "Lib/Environment.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
 #include "Kernel/Term.hpp"
 
 #include "SATClause.hpp"
@@ -36,6 +40,8 @@ SATLiteral SAT2FO::toSAT(Literal* l)
 {
   bool pol = l->isPositive();
   Literal* posLit = Literal::positiveLiteral(l);
+  // the map would be left with a dangling pointer otherwise
+  env.sharing->keepAlive(posLit);
   unsigned var = _posMap.get(posLit);
   return SATLiteral(var, pol);
 }
@@ -115,6 +115,16 @@ public:
    */
   virtual SATClause* getZeroImpliedCertificate(unsigned var) = 0;
 
+  /**
+   * Add to @b acc the variables whose value in the model may have changed
+   * since the previous call (or, for the first call, all the variables with a value)
+   * and return true. Solvers which don't keep track of this always return false.
+   *
+   * Allows the caller to update what it derived from the model
+   * in time proportional to the change rather than to the number of variables.
+   */
+  virtual bool collectChangedVars(Stack<unsigned>& acc) { return false; }
+
   /**
    * Ensure that clauses mentioning variables 1..newVarCnt can be handled.
    *
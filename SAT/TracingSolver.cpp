@@ -0,0 +1,220 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file TracingSolver.cpp
+ * Implements class TracingSolver.
+ */
+
+#include <cstring>
+#include <unistd.h>
+
+#include "Lib/Int.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "SATClause.hpp"
+
+#include "TracingSolver.hpp"
+
+namespace SAT
+{
+
+TracingSolver::TracingSolver(SATSolverWithAssumptions* inner, const std::string& fileName)
+ : _inner(inner), _out(fileName, std::ios::binary | std::ios::trunc)
+{
+  if (!_out) {
+    USER_ERROR("Cannot open the SAT trace file " + fileName);
+  }
+  _out.write(SAT_TRACE_MAGIC, strlen(SAT_TRACE_MAGIC));
+  _out.put(static_cast<char>(SAT_TRACE_VERSION));
+}
+
+TracingSolver::~TracingSolver()
+{
+  _out.flush();
+}
+
+SATSolverWithAssumptions* TracingSolver::traceIfRequested(SATSolverWithAssumptions* inner, const Shell::Options& opts, const char* user)
+{
+  if (opts.satTrace().empty()) {
+    return inner;
+  }
+  // each process of a portfolio writes its own traces, FMB creates a new solver for every domain size
+  static unsigned solverCnt = 0;
+  std::string fileName = opts.satTrace() + "." + user + "." + Int::toString(getpid()) + "." + Int::toString(solverCnt++) + ".trace";
+  return new TracingSolver(inner, fileName);
+}
+
+void TracingSolver::writeNumber(unsigned n)
+{
+  while (n >= 0x80) {
+    _out.put(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  _out.put(static_cast<char>(n));
+}
+
+void TracingSolver::writeClause(SATClause* cl)
+{
+  writeNumber(cl->length());
+  for (SATLiteral l : cl->iter()) {
+    writeLit(l);
+  }
+}
+
+void TracingSolver::addClause(SATClause* cl)
+{
+  writeOp(SATTraceOp::ADD_CLAUSE);
+  writeClause(cl);
+  _inner->addClause(cl);
+}
+
+void TracingSolver::addClauseIgnoredInPartialModel(SATClause* cl)
+{
+  writeOp(SATTraceOp::ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL);
+  writeClause(cl);
+  _inner->addClauseIgnoredInPartialModel(cl);
+}
+
+void TracingSolver::simplify()
+{
+  writeOp(SATTraceOp::SIMPLIFY);
+  _inner->simplify();
+}
+
+/**
+ * The record is written after the call returns, together with the result,
+ * and flushed, so that a trace of a killed process is usable up to the last call.
+ */
+SATSolver::Status TracingSolver::solve(unsigned conflictCountLimit)
+{
+  Status res = _inner->solve(conflictCountLimit);
+  writeOp(SATTraceOp::SOLVE);
+  writeNumber(conflictCountLimit);
+  writeNumber(static_cast<unsigned>(res));
+  _out.flush();
+  return res;
+}
+
+void TracingSolver::collectZeroImplied(SATLiteralStack& acc)
+{
+  unsigned sizeBefore = acc.size();
+  _inner->collectZeroImplied(acc);
+  writeOp(SATTraceOp::COLLECT_ZERO_IMPLIED);
+  writeNumber(acc.size() - sizeBefore);
+}
+
+void TracingSolver::ensureVarCount(unsigned newVarCnt)
+{
+  writeOp(SATTraceOp::ENSURE_VAR_COUNT);
+  writeNumber(newVarCnt);
+  _inner->ensureVarCount(newVarCnt);
+}
+
+unsigned TracingSolver::newVar()
+{
+  writeOp(SATTraceOp::NEW_VAR);
+  return _inner->newVar();
+}
+
+void TracingSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  writeOp(SATTraceOp::SUGGEST_POLARITY);
+  writeNumber(var);
+  writeNumber(pol);
+  _inner->suggestPolarity(var, pol);
+}
+
+void TracingSolver::addAssumption(SATLiteral lit)
+{
+  writeOp(SATTraceOp::ADD_ASSUMPTION);
+  writeLit(lit);
+  _inner->addAssumption(lit);
+}
+
+void TracingSolver::retractAllAssumptions()
+{
+  writeOp(SATTraceOp::RETRACT_ASSUMPTIONS);
+  _inner->retractAllAssumptions();
+}
+
+SATSolver::Status TracingSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets)
+{
+  Status res = _inner->solveUnderAssumptions(assumps, conflictCountLimit, onlyProperSubusets);
+  writeOp(SATTraceOp::SOLVE_UNDER_ASSUMPTIONS);
+  writeNumber(conflictCountLimit);
+  writeNumber(onlyProperSubusets);
+  writeNumber(assumps.size());
+  for (SATLiteral l : assumps) {
+    writeLit(l);
+  }
+  writeNumber(static_cast<unsigned>(res));
+  writeNumber(res == Status::UNSATISFIABLE ? _inner->failedAssumptions().size() : 0);
+  _out.flush();
+  return res;
+}
+
+const SATLiteralStack& TracingSolver::explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize)
+{
+  const SATLiteralStack& res = _inner->explicitlyMinimizedFailedAssumptions(conflictCountLimit, randomize);
+  writeOp(SATTraceOp::MINIMIZE_FAILED_ASSUMPTIONS);
+  writeNumber(conflictCountLimit);
+  writeNumber(randomize);
+  writeNumber(res.size());
+  return res;
+}
+
+SATTraceReader::SATTraceReader(const std::string& fileName)
+ : _in(fileName, std::ios::binary), _open(false)
+{
+  char header[sizeof(SAT_TRACE_MAGIC)];
+  if (_in.read(header, sizeof(header))) {
+    _open = memcmp(header, SAT_TRACE_MAGIC, strlen(SAT_TRACE_MAGIC)) == 0 &&
+            static_cast<uint8_t>(header[strlen(SAT_TRACE_MAGIC)]) == SAT_TRACE_VERSION;
+  }
+}
+
+bool SATTraceReader::readOp(SATTraceOp& op)
+{
+  int c = _in.get();
+  if (c == EOF) {
+    return false;
+  }
+  op = static_cast<SATTraceOp>(c);
+  return true;
+}
+
+bool SATTraceReader::readNumber(unsigned& n)
+{
+  n = 0;
+  for (unsigned shift = 0; shift < 35; shift += 7) {
+    int c = _in.get();
+    if (c == EOF) {
+      return false;
+    }
+    n |= static_cast<unsigned>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SATTraceReader::readLit(SATLiteral& l)
+{
+  unsigned n;
+  if (!readNumber(n)) {
+    return false;
+  }
+  l = SATLiteral(n >> 1, (n & 1) ? 0 : 1);
+  return true;
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file TracingSolver.hpp
+ * Defines class TracingSolver and the format of the SAT traces it writes.
+ *
+ * A trace is the magic string "VSATTRC" and a version byte followed by records.
+ * A record is a one byte SATTraceOp followed by its arguments,
+ * all of them unsigned LEB128 numbers. A literal is written as 2*var+1
+ * if negative and as 2*var if positive, a status as its numeric value.
+ *
+ *   NEW_VAR
+ *   ENSURE_VAR_COUNT count
+ *   ADD_CLAUSE size lit*
+ *   ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL size lit*
+ *   SIMPLIFY
+ *   SUGGEST_POLARITY var pol
+ *   ADD_ASSUMPTION lit
+ *   RETRACT_ASSUMPTIONS
+ *   SOLVE conflictLimit status
+ *   SOLVE_UNDER_ASSUMPTIONS conflictLimit onlyProperSubsets size lit* status failedCnt
+ *   MINIMIZE_FAILED_ASSUMPTIONS conflictLimit randomize minimizedCnt
+ *   COLLECT_ZERO_IMPLIED impliedCnt
+ *
+ * The recorded results allow a replay to check that another solver agrees.
+ * A trace may be cut short (e.g. when Vampire is killed), so a replay stops at the first incomplete record.
+ */
+
+#ifndef __TracingSolver__
+#define __TracingSolver__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "Forwards.hpp"
+
+#include "Lib/ScopedPtr.hpp"
+
+#include "SATSolver.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+enum class SATTraceOp : uint8_t {
+  NEW_VAR = 1,
+  ENSURE_VAR_COUNT,
+  ADD_CLAUSE,
+  ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL,
+  SIMPLIFY,
+  SUGGEST_POLARITY,
+  ADD_ASSUMPTION,
+  RETRACT_ASSUMPTIONS,
+  SOLVE,
+  SOLVE_UNDER_ASSUMPTIONS,
+  MINIMIZE_FAILED_ASSUMPTIONS,
+  COLLECT_ZERO_IMPLIED,
+};
+
+static constexpr char SAT_TRACE_MAGIC[] = "VSATTRC";
+static constexpr uint8_t SAT_TRACE_VERSION = 1;
+
+/**
+ * A SAT solver decorator writing all the calls that change the state
+ * of the inner solver into a trace file (see above). Queries of the
+ * assignment are only forwarded.
+ */
+class TracingSolver : public SATSolverWithAssumptions {
+public:
+  TracingSolver(SATSolverWithAssumptions* inner, const std::string& fileName);
+  ~TracingSolver() override;
+
+  /**
+   * Wrap @b inner into a TracingSolver if the option sat_trace is set.
+   * The file name tells the @b user of the solver, the process and the solver instance apart.
+   */
+  static SATSolverWithAssumptions* traceIfRequested(SATSolverWithAssumptions* inner, const Shell::Options& opts, const char* user);
+
+  SATClause* getRefutation() override { return _inner->getRefutation(); }
+  SATClauseList* getRefutationPremiseList() override { return _inner->getRefutationPremiseList(); }
+
+  void addClause(SATClause* cl) override;
+  void addClauseIgnoredInPartialModel(SATClause* cl) override;
+  void simplify() override;
+  Status solve(unsigned conflictCountLimit) override;
+
+  VarAssignment getAssignment(unsigned var) override { return _inner->getAssignment(var); }
+  bool isZeroImplied(unsigned var) override { return _inner->isZeroImplied(var); }
+  void collectZeroImplied(SATLiteralStack& acc) override;
+  SATClause* getZeroImpliedCertificate(unsigned var) override { return _inner->getZeroImpliedCertificate(var); }
+  bool collectChangedVars(Stack<unsigned>& acc) override { return _inner->collectChangedVars(acc); }
+
+  void ensureVarCount(unsigned newVarCnt) override;
+  unsigned newVar() override;
+  void suggestPolarity(unsigned var, unsigned pol) override;
+
+  void addAssumption(SATLiteral lit) override;
+  void retractAllAssumptions() override;
+  bool hasAssumptions() const override { return _inner->hasAssumptions(); }
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets) override;
+  const SATLiteralStack& failedAssumptions() override { return _inner->failedAssumptions(); }
+  const SATLiteralStack& explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize) override;
+
+private:
+  void writeOp(SATTraceOp op) { _out.put(static_cast<char>(op)); }
+  void writeNumber(unsigned n);
+  void writeLit(SATLiteral l) { writeNumber(2*l.var() + (l.isNegative() ? 1 : 0)); }
+  void writeClause(SATClause* cl);
+
+  ScopedPtr<SATSolverWithAssumptions> _inner;
+  std::ofstream _out;
+};
+
+/**
+ * Reads the records of a trace written by TracingSolver.
+ */
+class SATTraceReader {
+public:
+  /** Open @b fileName and check the header; if that fails, isOpen() is false */
+  SATTraceReader(const std::string& fileName);
+
+  bool isOpen() const { return _open; }
+
+  /** Read the next operation, return false at the end of the trace */
+  bool readOp(SATTraceOp& op);
+  /** Read an argument of the last operation, return false if the trace is cut short */
+  bool readNumber(unsigned& n);
+  bool readLit(SATLiteral& l);
+
+private:
+  std::ifstream _in;
+  bool _open;
+};
+
+}
+
+#endif // __TracingSolver__
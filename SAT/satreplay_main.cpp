@@ -0,0 +1,238 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file satreplay_main.cpp
+ * Replays SAT traces recorded with the option sat_trace (see TracingSolver.hpp)
+ * against one of Vampire's SAT solvers and reports the time spent.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Lib/Environment.hpp"
+#include "Lib/ScopedPtr.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/MinisatInterfacing.hpp"
+#include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/SATClause.hpp"
+#include "SAT/TracingSolver.hpp"
+
+using namespace Lib;
+using namespace SAT;
+
+using Clock = std::chrono::steady_clock;
+
+struct ReplayStats {
+  unsigned calls = 0;
+  unsigned solves = 0;
+  /** solve calls where neither the recorded nor the replayed status is UNKNOWN and they differ */
+  unsigned disagreements = 0;
+  /** solve calls where exactly one of the recorded and the replayed status is UNKNOWN */
+  unsigned unknownDifferences = 0;
+  Clock::duration solveTime = Clock::duration::zero();
+  Clock::duration totalTime = Clock::duration::zero();
+};
+
+static SATSolverWithAssumptions* createSolver(const std::string& name)
+{
+  if (name == "minisat") {
+    return new MinisatInterfacing(*env.options, true);
+  }
+  if (name == "minisat_simp") {
+    return new MinisatInterfacingNewSimp(*env.options, true);
+  }
+  if (name == "cdcl") {
+    return new CDCLSolver(*env.options, true);
+  }
+  return nullptr;
+}
+
+static bool readClause(SATTraceReader& in, SATClause*& cl)
+{
+  unsigned size;
+  if (!in.readNumber(size)) {
+    return false;
+  }
+  SATLiteralStack lits;
+  for (unsigned i = 0; i < size; i++) {
+    SATLiteral l;
+    if (!in.readLit(l)) {
+      return false;
+    }
+    lits.push(l);
+  }
+  // not owned by the solver, the clause lives till the end
+  cl = SATClause::fromStack(lits);
+  return true;
+}
+
+static void compareStatus(unsigned recorded, SATSolver::Status replayed, ReplayStats& stats)
+{
+  auto unknown = static_cast<unsigned>(SATSolver::Status::UNKNOWN);
+  if (recorded == static_cast<unsigned>(replayed)) {
+    return;
+  }
+  if (recorded == unknown || replayed == SATSolver::Status::UNKNOWN) {
+    stats.unknownDifferences++;
+  } else {
+    stats.disagreements++;
+  }
+}
+
+/**
+ * Replay the trace @b in on @b s. Return false if the trace is malformed
+ * (a trace cut short is not considered malformed).
+ */
+static bool replay(SATTraceReader& in, SATSolverWithAssumptions& s, ReplayStats& stats)
+{
+  Clock::time_point start = Clock::now();
+  SATLiteralStack lits;
+  SATTraceOp op;
+  while (in.readOp(op)) {
+    unsigned n, limit, flag, recorded, cnt;
+    SATLiteral l;
+    SATClause* cl;
+    stats.calls++;
+    switch (op) {
+      case SATTraceOp::NEW_VAR:
+        s.newVar();
+        break;
+      case SATTraceOp::ENSURE_VAR_COUNT:
+        if (!in.readNumber(n)) { goto cutShort; }
+        s.ensureVarCount(n);
+        break;
+      case SATTraceOp::ADD_CLAUSE:
+        if (!readClause(in, cl)) { goto cutShort; }
+        s.addClause(cl);
+        break;
+      case SATTraceOp::ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL:
+        if (!readClause(in, cl)) { goto cutShort; }
+        s.addClauseIgnoredInPartialModel(cl);
+        break;
+      case SATTraceOp::SIMPLIFY:
+        s.simplify();
+        break;
+      case SATTraceOp::SUGGEST_POLARITY:
+        if (!in.readNumber(n) || !in.readNumber(flag)) { goto cutShort; }
+        s.suggestPolarity(n, flag);
+        break;
+      case SATTraceOp::ADD_ASSUMPTION:
+        if (!in.readLit(l)) { goto cutShort; }
+        s.addAssumption(l);
+        break;
+      case SATTraceOp::RETRACT_ASSUMPTIONS:
+        s.retractAllAssumptions();
+        break;
+      case SATTraceOp::SOLVE: {
+        if (!in.readNumber(limit) || !in.readNumber(recorded)) { goto cutShort; }
+        Clock::time_point solveStart = Clock::now();
+        SATSolver::Status res = s.solve(limit);
+        stats.solveTime += Clock::now() - solveStart;
+        stats.solves++;
+        compareStatus(recorded, res, stats);
+        break;
+      }
+      case SATTraceOp::SOLVE_UNDER_ASSUMPTIONS: {
+        if (!in.readNumber(limit) || !in.readNumber(flag) || !in.readNumber(n)) { goto cutShort; }
+        lits.reset();
+        for (unsigned i = 0; i < n; i++) {
+          if (!in.readLit(l)) { goto cutShort; }
+          lits.push(l);
+        }
+        if (!in.readNumber(recorded) || !in.readNumber(cnt)) { goto cutShort; }
+        Clock::time_point solveStart = Clock::now();
+        SATSolver::Status res = s.solveUnderAssumptions(lits, limit, flag);
+        stats.solveTime += Clock::now() - solveStart;
+        stats.solves++;
+        compareStatus(recorded, res, stats);
+        break;
+      }
+      case SATTraceOp::MINIMIZE_FAILED_ASSUMPTIONS: {
+        if (!in.readNumber(limit) || !in.readNumber(flag) || !in.readNumber(cnt)) { goto cutShort; }
+        Clock::time_point solveStart = Clock::now();
+        s.explicitlyMinimizedFailedAssumptions(limit, flag);
+        stats.solveTime += Clock::now() - solveStart;
+        break;
+      }
+      case SATTraceOp::COLLECT_ZERO_IMPLIED:
+        if (!in.readNumber(cnt)) { goto cutShort; }
+        lits.reset();
+        s.collectZeroImplied(lits);
+        break;
+      default:
+        std::cerr << "unknown operation " << static_cast<unsigned>(op) << std::endl;
+        return false;
+    }
+  }
+cutShort:
+  stats.totalTime += Clock::now() - start;
+  return true;
+}
+
+static double toMs(Clock::duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static void print(const std::string& name, const ReplayStats& stats)
+{
+  std::cout << std::fixed << std::setprecision(1)
+            << name << ": " << stats.calls << " calls, " << stats.solves << " solves, "
+            << toMs(stats.solveTime) << " ms solving, " << toMs(stats.totalTime) << " ms total, "
+            << stats.disagreements << " disagreements, "
+            << stats.unknownDifferences << " unknown differences" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  SATSolverWithAssumptions* probe = (argc >= 3) ? createSolver(argv[1]) : nullptr;
+  if (!probe) {
+    char const* program = (argc >= 1) ? argv[0] : "satreplay";
+    std::cout << "Usage: " << program << " minisat|minisat_simp|cdcl TRACE..." << std::endl;
+    return 1;
+  }
+  delete probe;
+
+  std::string solverName{argv[1]};
+  ReplayStats total;
+  bool ok = true;
+  for (int i = 2; i < argc; ++i) {
+    std::string fileName{argv[i]};
+    SATTraceReader in(fileName);
+    if (!in.isOpen()) {
+      std::cerr << fileName << ": not a SAT trace" << std::endl;
+      ok = false;
+      continue;
+    }
+
+    ScopedPtr<SATSolverWithAssumptions> solver(createSolver(solverName));
+    ReplayStats stats;
+    if (!replay(in, *solver, stats)) {
+      std::cerr << fileName << ": malformed trace" << std::endl;
+      ok = false;
+    }
+    print(fileName, stats);
+
+    total.calls += stats.calls;
+    total.solves += stats.solves;
+    total.disagreements += stats.disagreements;
+    total.unknownDifferences += stats.unknownDifferences;
+    total.solveTime += stats.solveTime;
+    total.totalTime += stats.totalTime;
+  }
+  print("TOTAL " + solverName, total);
+
+  return (ok && !total.disagreements) ? 0 : 1;
+}
@@ -639,6 +639,18 @@ bool AWPassiveClauseContainer::weightLimited() const
   return _weightRatio > 0 && _weightSelectionMaxWeight != UINT_MAX && _weightSelectionMaxAge != UINT_MAX;
 }
 
+void AWPassiveClauseContainer::printLimits(std::ostream& out) const
+{
+  if (ageLimited()) {
+    out << ", \"age_selection_max_age\": " << _ageSelectionMaxAge
+        << ", \"age_selection_max_weight\": " << _ageSelectionMaxWeight;
+  }
+  if (weightLimited()) {
+    out << ", \"weight_selection_max_weight\": " << _weightSelectionMaxWeight
+        << ", \"weight_selection_max_age\": " << _weightSelectionMaxAge;
+  }
+}
+
 bool AWPassiveClauseContainer::fulfilsAgeLimit(Clause* cl) const
 {
   // don't want to reuse fulfilsAgeLimit(unsigned age,..) here, since we don't want to recompute weightForClauseSelection
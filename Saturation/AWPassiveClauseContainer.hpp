@@ -144,6 +144,8 @@ public:
   bool fulfilsWeightLimit(unsigned w, unsigned numPositiveLiterals, const Inference& inference) const override;
 
   bool childrenPotentiallyFulfilLimits(Clause* cl, unsigned upperBoundNumSelLits) const override;
+
+  void printLimits(std::ostream& out) const override;
 }; // class AWPassiveClauseContainer
 
 
@@ -100,6 +100,8 @@ public:
   Clause* pop();
   bool isEmpty() const
   { return _data.isEmpty(); }
+  unsigned size() const
+  { return _data.size(); }
 private:
   Deque<Clause*> _data;
 };
@@ -156,6 +158,9 @@ public:
   
   virtual bool childrenPotentiallyFulfilLimits(Clause* cl, unsigned upperBoundNumSelLits) const = 0;
 
+  /** Print the current limits as members of a JSON object, each preceded by a comma */
+  virtual void printLimits(std::ostream& out) const {}
+
 protected:
   bool _isOutermost;
   const Shell::Options& _opt;
@@ -11,6 +11,9 @@
  * @file SaturationAlgorithm.cpp
  * Implementing SaturationAlgorithm class.
  */
+#include <sstream>
+#include <unistd.h>
+
 #include "Debug/RuntimeStatistics.hpp"
 
 #include "Lib/DHSet.hpp"
@@ -23,6 +26,7 @@
 #include "Lib/System.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/ColorHelper.hpp"
@@ -218,12 +222,18 @@ SaturationAlgorithm::SaturationAlgorithm(Problem &prb, const Options &opt)
       _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
       _instantiation(0), _fnDefHandler(prb.getFunctionDefinitionHandler()),
       _generatedClauseCount(0),
-      _activationLimit(0)
+      _activationLimit(0),
+      _termCollectionLimit(0)
 {
   ASS_EQ(s_instance, 0); // there can be only one saturation algorithm at a time
 
   _activationLimit = opt.activationLimit();
 
+  if (!opt.statisticsSnapshotFile().empty()) {
+    _snapshot = std::make_unique<StatisticsSnapshot>(opt.statisticsSnapshotFile(),
+        opt.statisticsSnapshotActivations(), opt.statisticsSnapshotPeriod());
+  }
+
   _ordering = OrderingSP(Ordering::create(prb, opt));
   if (!Ordering::trySetGlobalOrdering(_ordering)) {
     // this is not an error, it may just lead to lower performance (and most likely not significantly lower)
@@ -510,6 +520,9 @@ void SaturationAlgorithm::onClauseReduction(Clause *cl, Clause **replacements, u
   premStack.loadFromIterator(premises);
 
   Clause *replacement = numOfReplacements ? *replacements : 0;
+  if (!replacement) {
+    env.statistics->deletedClauses++;
+  }
 
   if (env.options->showReductions()) {
     std::cout << "[SA] " << (forward ? "forward" : "backward") << " reduce: " << cl->toString() << endl;
@@ -737,6 +750,51 @@ void SaturationAlgorithm::init()
   if (_symEl) {
     _symEl->init(this);
   }
+
+  // collection only starts here, so terms of the problem, the signature etc. are never collected;
+  // theory and higher-order reasoning cache terms outside of clauses and indices
+  if (_opt.termSharingGC() && !_prb.isHigherOrder() && !_prb.hasFOOL() &&
+      !_prb.hasInterpretedOperations() && !_prb.hasNumerals()) {
+    _termCollectionLimit = _opt.termSharingGC() * 1000;
+    env.sharing->enableCollection();
+  }
+}
+
+/**
+ * Free the shared terms that are no longer used and adjust the limit
+ * for the next collection to the number of terms that survived.
+ */
+void SaturationAlgorithm::collectTerms()
+{
+  env.statistics->termCollections++;
+  env.statistics->collectedTerms += env.sharing->collectGarbage();
+  _termCollectionLimit = std::max(_termCollectionLimit, 2 * env.sharing->collectableCount());
+}
+
+/**
+ * Write a snapshot of the statistics of the run so far as a line of JSON
+ */
+void SaturationAlgorithm::writeSnapshot()
+{
+  Statistics& stats = *env.statistics;
+  std::ostringstream out;
+  out << "{\"pid\": " << getpid()
+      << ", \"time_ms\": " << Timer::elapsedMilliseconds()
+      << ", \"activations\": " << stats.activations
+      << ", \"active\": " << _active->sizeEstimate()
+      << ", \"passive\": " << _passive->sizeEstimate()
+      << ", \"unprocessed\": " << _unprocessed->size()
+      << ", \"generated\": " << stats.generatedClauses
+      << ", \"retained\": " << stats.passiveClauses
+      << ", \"deleted\": " << stats.deletedClauses
+      << ", \"index_clauses\": ";
+  _imgr->printClauseCounts(out);
+  out << ", \"shared_terms\": " << env.sharing->termCount()
+      << ", \"shared_literals\": " << env.sharing->literalCount()
+      << ", \"memory_kb\": " << StatisticsSnapshot::memoryInUse();
+  _passive->printLimits(out);
+  out << "}";
+  _snapshot->write(out.str());
 }
 
 Clause *SaturationAlgorithm::doImmediateSimplification(Clause *cl0)
@@ -1315,8 +1373,15 @@ void SaturationAlgorithm::doOneAlgorithmStep()
     cl = _passive->popSelected();
   }
   ASS_EQ(cl->store(), Clause::PASSIVE);
+  bool retrievable = !_splitter || _splitter->isRetrievable(cl);
   cl->setStore(Clause::SELECTED);
 
+  if (!retrievable) {
+    // left in passive by lazy AVATAR deactivation, it stays among the children of its split levels
+    removeSelected(cl);
+    return;
+  }
+
   if (!handleClauseBeforeActivation(cl)) {
     return;
   }
@@ -1341,9 +1406,15 @@ MainLoopResult SaturationAlgorithm::runImpl()
       }
       if (_softTimeLimit && Timer::elapsedDeciseconds() - startTime > _softTimeLimit)
         throw TimeLimitExceededException();
+      if (_termCollectionLimit && env.sharing->collectableCount() > _termCollectionLimit) {
+        collectTerms();
+      }
 
       doOneAlgorithmStep();
       env.statistics->activations = l;
+      if (_snapshot && _snapshot->due(l)) {
+        writeSnapshot();
+      }
     }
   }
   catch (ThrowableBase &) {
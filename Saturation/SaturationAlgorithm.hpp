@@ -35,6 +35,8 @@
 
 #include "Saturation/ExtensionalityClauseContainer.hpp"
 
+#include "Shell/StatisticsSnapshot.hpp"
+
 #if VDEBUG
 #include<iostream>
 #endif
@@ -240,7 +242,14 @@ protected:
   unsigned _generatedClauseCount;
 
   unsigned _activationLimit;
+  /** collect garbage shared terms once there are more collectable ones, 0 if disabled */
+  unsigned _termCollectionLimit;
+  /** writes snapshots of the statistics during saturation, if requested */
+  std::unique_ptr<Shell::StatisticsSnapshot> _snapshot;
 private:
+  void collectTerms();
+  void writeSnapshot();
+
   static ImmediateSimplificationEngine* createISE(Problem& prb, const Options& opt, Ordering& ordering);
 
   // a "soft" time limit in deciseconds, checked manually: 0 is no limit
@@ -34,6 +34,9 @@
 #include "Kernel/FormulaUnit.hpp"
 #include "Kernel/MainLoop.hpp"
 
+#include "Indexing/Index.hpp"
+#include "Indexing/TermSharing.hpp"
+
 #include "Shell/ConditionalRedundancyHandler.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
@@ -42,8 +45,10 @@
 #include "SAT/SATInference.hpp"
 #include "SAT/MinimizingSolver.hpp"
 #include "SAT/BufferedSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/TracingSolver.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "DP/ShortConflictMetaDP.hpp"
@@ -68,7 +73,10 @@ void SplittingBranchSelector::init()
 
   switch(_parent.getOptions().satSolver()){
     case Options::SatSolver::MINISAT:
-      _solver = new MinisatInterfacing(_parent.getOptions(),true);
+      _solver = TracingSolver::traceIfRequested(new MinisatInterfacing(_parent.getOptions(),true),_parent.getOptions(),"avatar");
+      break;
+    case Options::SatSolver::CDCL:
+      _solver = TracingSolver::traceIfRequested(new CDCLSolver(_parent.getOptions(),true),_parent.getOptions(),"avatar");
       break;
 #if VZ3
     case Options::SatSolver::Z3:
@@ -115,7 +123,100 @@ void SplittingBranchSelector::init()
     if (_ccModel) {
       _dpModel = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
     }
-  }  
+  }
+
+  // the cc-model overrides the solver's model (see getSolverAssimentConsideringCCModel),
+  // and only some solvers (not the minimizing one) can tell which variables changed
+  Stack<unsigned> probe;
+  _incrementalModel = _parent.getOptions().splittingIncrementalModel() && !_ccModel && _solver->collectChangedVars(probe);
+}
+
+/**
+ * With _incrementalModel, the selection for @b name's variable is to be updated
+ * even if its value doesn't change.
+ */
+void SplittingBranchSelector::componentNameUsed(SplitLevel name)
+{
+  if (_incrementalModel) {
+    _changedVars.push(_parent.getLiteralFromName(name).var());
+  }
+}
+
+/**
+ * With _incrementalModel, fetch the variables changed by the last solver calls
+ * and update the ground assignment, and the literals asserted to _dp, for them.
+ *
+ * The i-th literal of _gndAssignment is asserted to _dp on the i-th backtracking level.
+ * A literal no longer true is retracted by popping the levels from its one up
+ * and asserting again the literals above it that are still true.
+ */
+void SplittingBranchSelector::collectModelChanges()
+{
+  ASS(_incrementalModel);
+
+  unsigned start = _changedVars.size();
+  ALWAYS(_solver->collectChangedVars(_changedVars));
+  if (!_dp) {
+    return;
+  }
+  ASS(_dp->supportsBacktracking());
+
+  static Stack<std::pair<unsigned,Literal*>> toAssert;
+  toAssert.reset();
+
+  SAT2FO& s2f = _parent.satNaming();
+  unsigned maxSatVar = _parent.maxSatVar();
+  unsigned keep = _gndAssignment.size();
+  for (unsigned i = start; i < _changedVars.size(); i++) {
+    unsigned var = _changedVars[i];
+    if (var > maxSatVar) {
+      continue;
+    }
+    unsigned pos;
+    if (_gndAssignmentPos.pop(var, pos)) {
+      _gndAssignment[pos].second = nullptr;
+      keep = std::min(keep, pos);
+    }
+    SATSolver::VarAssignment asgn = _solver->getAssignment(var);
+    if (asgn == SATSolver::VarAssignment::DONT_CARE) {
+      continue;
+    }
+    Literal* lit = s2f.toFO(SATLiteral(var, asgn == SATSolver::VarAssignment::TRUE));
+    if (lit) {
+      toAssert.push(std::make_pair(var, lit));
+    }
+  }
+
+  if (keep < _gndAssignment.size()) {
+    // the literals still true go below the new ones, as they are likely to stay longer
+    static Stack<std::pair<unsigned,Literal*>> survivors;
+    survivors.reset();
+    for (unsigned i = keep; i < _gndAssignment.size(); i++) {
+      if (_gndAssignment[i].second) {
+        survivors.push(_gndAssignment[i]);
+        _gndAssignmentPos.remove(_gndAssignment[i].first);
+      }
+    }
+    _dp->pop(_gndAssignment.size() - keep);
+    _gndAssignment.truncate(keep);
+    for (auto& p : survivors) {
+      assertToDP(p.first, p.second);
+    }
+  }
+  for (auto& p : toAssert) {
+    assertToDP(p.first, p.second);
+  }
+}
+
+void SplittingBranchSelector::assertToDP(unsigned var, Literal* lit)
+{
+  if (!_gndAssignmentPos.insert(var, _gndAssignment.size())) {
+    // the variable was reported as changed twice
+    return;
+  }
+  _gndAssignment.push(std::make_pair(var, lit));
+  _dp->push();
+  _dp->addLiterals(pvi(getSingletonIterator(lit)));
 }
 
 void SplittingBranchSelector::updateVarCnt()
@@ -393,13 +494,18 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
     {
       TIME_TRACE("congruence closure");
     
-      gndAssignment.reset();
-      // collects only ground literals, because it known only about them ...
-      s2f.collectAssignment(*_solver, gndAssignment); 
-      // ... moreover, _dp->addLiterals will filter the set anyway
+      if (_incrementalModel) {
+        // only the changed part of the assignment is looked at and asserted
+        collectModelChanges();
+      } else {
+        gndAssignment.reset();
+        // collects only ground literals, because it known only about them ...
+        s2f.collectAssignment(*_solver, gndAssignment);
+        // ... moreover, _dp->addLiterals will filter the set anyway
 
-      _dp->reset();
-      _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+        _dp->reset();
+        _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+      }
       DecisionProcedure::Status dpStatus = _dp->getStatus(_ccMultipleCores);
 
       if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
@@ -594,6 +700,17 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   }
   ASS_EQ(stat,SATSolver::Status::SATISFIABLE);
 
+  if (_incrementalModel) {
+    collectModelChanges();
+    for (unsigned var : _changedVars) {
+      if (var <= maxSatVar) {
+        updateSelection(var, _solver->getAssignment(var), addedComps, removedComps);
+      }
+    }
+    _changedVars.reset();
+    return;
+  }
+
   for(unsigned i=1; i<=maxSatVar; i++) {
     SATSolver::VarAssignment asgn = getSolverAssimentConsideringCCModel(i);
 
@@ -618,8 +735,8 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
 std::string Splitter::splPrefix = "";
 
 Splitter::Splitter()
-: _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _branchSelector(*this),
-  _clausesAdded(false), _haveBranchRefutation(false)
+: _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _lazyDeactivation(0), _branchSelector(*this),
+  _clausesAdded(false), _haveBranchRefutation(false), _modelEpoch(1)
 {
   if(env.options->proof()==Options::Proof::TPTP){
     unsigned spl = env.signature->addFreshFunction(0,"spl");
@@ -629,6 +746,9 @@ Splitter::Splitter()
 
 Splitter::~Splitter()
 {
+  while (_deactivated.isNonEmpty()) {
+    _deactivated.pop_front().clause->decRefCnt();
+  }
   while(_db.isNonEmpty()) {
     if(_db.top()) {
       delete _db.top();
@@ -696,6 +816,7 @@ void Splitter::init(SaturationAlgorithm* sa)
 
   _fastRestart = opts.splittingFastRestart();
   _deleteDeactivated = opts.splittingDeleteDeactivated();
+  _lazyDeactivation = opts.splittingLazyDeactivation();
 
   if (opts.useHashingVariantIndex()) {
     _componentIdx = new HashingClauseVariantIndex();
@@ -825,6 +946,12 @@ void Splitter::onAllProcessed()
     if(toAdd.isNonEmpty()) {
       addComponents(toAdd);
     }
+    if (toRemove.isNonEmpty() || toAdd.isNonEmpty()) {
+      _modelEpoch++;
+    }
+    if (_lazyDeactivation) {
+      evictDeactivated();
+    }
 
     // now that new activ-ness has been determined
     // we can put back the fast clauses, if any
@@ -1267,6 +1394,7 @@ Clause* Splitter::buildAndInsertComponentClause(SplitLevel name, unsigned size,
   }
 
   _db[name] = new SplitRecord(compCl);
+  _branchSelector.componentNameUsed(name);
   compCl->setSplits(SplitSet::getSingleton(name));
   compCl->setComponent(true);
 
@@ -1279,6 +1407,7 @@ Clause* Splitter::buildAndInsertComponentClause(SplitLevel name, unsigned size,
   
   {
     TIME_TRACE("splitting component index maintenance");
+    Indexing::TermSharing::KeepAliveScope keep(_componentIdx.ptr(), compCl);
     _componentIdx->insert(compCl);
   }
 
@@ -1671,11 +1800,30 @@ void Splitter::addComponents(const SplitLevelStack& toAdd)
     sr->active = true;
     
     if (_deleteDeactivated == Options::SplittingDeleteDeactivated::ON) {
-      ASS(sr->children.isEmpty());
-      //we need to put the component clause among children, 
-      //so that it is backtracked when we remove the component
-      sr->children.push(sr->component);
-      _sa->addNewClause(sr->component);
+      // only lazily deactivated clauses were kept, see removeComponents
+      bool componentKept = false;
+      RCClauseStack::DelIterator chit(sr->children);
+      while (chit.hasNext()) {
+        Clause* cl = chit.next();
+        ASS(_lazyDeactivation);
+        if (cl->store() != Clause::PASSIVE) {
+          // evicted or dropped by clause selection in the meantime
+          chit.del();
+          continue;
+        }
+        cl->incNumActiveSplits();
+        if (cl->getNumActiveSplits() == (int)cl->splits()->size()) {
+          ASS(allSplitLevelsActive(cl->splits()));
+          env.statistics->lazilyReactivatedClauses++;
+        }
+        componentKept |= cl == sr->component;
+      }
+      if (!componentKept) {
+        //we need to put the component clause among children, 
+        //so that it is backtracked when we remove the component
+        sr->children.push(sr->component);
+        _sa->addNewClause(sr->component);
+      }
     } else {
       // children were kept, so we just put them back
       RCClauseStack::Iterator chit(sr->children);
@@ -1683,9 +1831,15 @@ void Splitter::addComponents(const SplitLevelStack& toAdd)
         Clause* cl = chit.next();
         cl->incNumActiveSplits();
         if (cl->getNumActiveSplits() == (int)cl->splits()->size()) {
-          _sa->addNewClause(cl);
           //check that restored clause does not depend on inactive splits
           ASS(allSplitLevelsActive(cl->splits()));
+          if (cl->store() == Clause::PASSIVE) {
+            // deactivated lazily and still in passive, nothing to restore
+            ASS(_lazyDeactivation);
+            env.statistics->lazilyReactivatedClauses++;
+          } else {
+            _sa->addNewClause(cl);
+          }
         }
       }
     }
@@ -1716,21 +1870,34 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
     while (chit.hasNext()) {
       Clause* ccl=chit.next();
       ASS(ccl->splits()->member(bl));
-      if(ccl->store()!=Clause::NONE) {
+      if (_lazyDeactivation && ccl->store()==Clause::PASSIVE) {
+        deactivateLazily(ccl);
+      } else if(ccl->store()!=Clause::NONE) {
         _sa->removeActiveOrPassiveClause(ccl);
         ASS_EQ(ccl->store(), Clause::NONE);
-      } else {
       }
       ccl->invalidateMyReductionRecords();
       ccl->decNumActiveSplits();
-      if (ccl->getNumActiveSplits() < NOT_WORTH_REINTRODUCING) {
+      // a lazily deactivated clause stays among children until it is evicted
+      if (ccl->getNumActiveSplits() < NOT_WORTH_REINTRODUCING && ccl->store()==Clause::NONE) {
         RSTAT_CTR_INC("unworthy child removed");
         chit.del();
       }
     }
     
     if (_deleteDeactivated == Options::SplittingDeleteDeactivated::ON) {
-      sr->children.reset();
+      if (_lazyDeactivation) {
+        // a lazily deactivated clause becomes selectable again when the level comes back,
+        // so it must stay among the children to be removed on the next deactivation
+        RCClauseStack::DelIterator lit(sr->children);
+        while (lit.hasNext()) {
+          if (lit.next()->store() != Clause::PASSIVE) {
+            lit.del();
+          }
+        }
+      } else {
+        sr->children.reset();
+      }
     }
 
     while (sr->conditionalRedundancyEntries.isNonEmpty()) {
@@ -1776,6 +1943,72 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
   }
 }
 
+/**
+ * Leave the passive clause @b cl, one of whose components was just deactivated,
+ * in passive instead of removing it. Until it is evicted by @b evictDeactivated,
+ * @b isRetrievable hides it from index retrieval and clause selection.
+ */
+void Splitter::deactivateLazily(Clause* cl)
+{
+  ASS(_lazyDeactivation);
+  ASS_EQ(cl->store(), Clause::PASSIVE);
+
+  // the epoch is only incremented after the whole model update
+  unsigned* since;
+  if (!_deactivatedSince.getValuePtr(cl, since) && *since == _modelEpoch) {
+    return; // several of its components got deactivated at once
+  }
+  *since = _modelEpoch;
+  cl->incRefCnt(); // dec when popped from _deactivated
+  _deactivated.push_back(DeactivationRecord{ cl, _modelEpoch });
+  env.statistics->lazilyDeactivatedClauses++;
+}
+
+/**
+ * Remove from passive the lazily deactivated clauses which stayed inactive
+ * for at least @b _lazyDeactivation model changes after the one that deactivated them.
+ * Their records hold the epoch before that change, see deactivateLazily.
+ */
+void Splitter::evictDeactivated()
+{
+  // unlike removeComponents, this runs after addComponents may have added new
+  // clauses, but it only removes passive ones, so these are not affected
+  while (_deactivated.isNonEmpty() && _deactivated.front().epoch + _lazyDeactivation < _modelEpoch) {
+    DeactivationRecord rec = _deactivated.pop_front();
+    Clause* cl = rec.clause;
+
+    unsigned since;
+    if (_deactivatedSince.find(cl, since) && since == rec.epoch) {
+      _deactivatedSince.remove(cl);
+      // the clause may have been reactivated or selected in the meantime
+      if (cl->store() == Clause::PASSIVE && !isRetrievable(cl)) {
+        _sa->removeActiveOrPassiveClause(cl);
+        env.statistics->lazilyEvictedClauses++;
+      }
+    }
+    cl->decRefCnt(); // inc in deactivateLazily
+  }
+}
+
+/**
+ * Return false iff @b cl is a lazily deactivated clause, which must not take
+ * part in any inference. Whether all split levels of a clause are active is
+ * cached in the clause for the current model epoch.
+ */
+bool Splitter::isRetrievable(Clause* cl)
+{
+  // only passive clauses are deactivated lazily
+  if (!_lazyDeactivation || cl->store() != Clause::PASSIVE) {
+    return true;
+  }
+  bool active;
+  if (!cl->splitsActiveIn(_modelEpoch, active)) {
+    active = allSplitLevelsActive(cl->splits());
+    cl->setSplitsActiveIn(_modelEpoch, active);
+  }
+  return active;
+}
+
 /**
  * Given a set of clauses (as obtained by saturation)
  * add in front of that list the component clauses currently assumed true in our (last) model.
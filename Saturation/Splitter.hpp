@@ -19,6 +19,7 @@
 
 #include "Lib/Allocator.hpp"
 #include "Lib/ArrayMap.hpp"
+#include "Lib/Deque.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Hash.hpp"
 #include "Lib/Stack.hpp"
@@ -57,7 +58,7 @@ class Splitter;
  */
 class SplittingBranchSelector {
 public:
-  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent), _solverIsSMT(false)  {}
+  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _incrementalModel(false), _parent(parent), _solverIsSMT(false)  {}
   ~SplittingBranchSelector(){
 #if VZ3
 _solver=0;
@@ -75,10 +76,14 @@ _solver=0;
 
   void flush(SplitLevelStack& addedComps, SplitLevelStack& removedComps);
 
+  void componentNameUsed(SplitLevel name);
+
 private:
   friend class Splitter;
 
   SATSolver::Status processDPConflicts();
+  void collectModelChanges();
+  void assertToDP(unsigned var, Literal* lit);
   SATSolver::VarAssignment getSolverAssimentConsideringCCModel(unsigned var);
 
   void handleSatRefutation();
@@ -93,6 +98,7 @@ private:
   bool _ccMultipleCores;
   bool _minSCO; // minimize wrt splitting clauses only
   bool _ccModel;
+  bool _incrementalModel;
 
   Splitter& _parent;
 
@@ -112,6 +118,19 @@ private:
    */
   ArraySet _trueInCCModel;
 
+  /**
+   * With _incrementalModel, the variables the selection may need updating for:
+   * those reported as changed by the solver and those with a newly used name.
+   */
+  Stack<unsigned> _changedVars;
+  /**
+   * With _incrementalModel, the ground FO literals true in the current model
+   * (with their SAT variables) in the order they are asserted to _dp
+   * and the positions of the variables in there.
+   */
+  Stack<std::pair<unsigned,Literal*>> _gndAssignment;
+  DHMap<unsigned,unsigned> _gndAssignmentPos;
+
 #if VDEBUG
   unsigned lastCheckedVar;
 #endif
@@ -189,6 +208,7 @@ public:
   void onNewClause(Clause* cl);
   void onAllProcessed();
   bool handleEmptyClause(Clause* cl);
+  bool isRetrievable(Clause* cl);
 
   SplitLevel getNameFromLiteral(SATLiteral lit) const;
   Unit* getDefinitionFromName(SplitLevel compName) const;
@@ -229,6 +249,8 @@ private:
 
   void addComponents(const SplitLevelStack& toAdd);
   void removeComponents(const SplitLevelStack& toRemove);
+  void deactivateLazily(Clause* cl);
+  void evictDeactivated();
 
   void collectDependenceLits(SplitSet* splits, SATLiteralStack& acc) const;
 
@@ -255,6 +277,7 @@ private:
   unsigned _flushPeriod;
   float _flushQuotient;
   Options::SplittingDeleteDeactivated _deleteDeactivated;
+  unsigned _lazyDeactivation;
   Options::SplittingCongruenceClosure _congruenceClosure;
   bool _shuffleComponents;
 #if VZ3
@@ -308,7 +331,24 @@ private:
    * and will invariably change the SAT model.
    */
   RCClauseStack _fastClauses;
-  
+
+  /** incremented whenever the set of active components changes */
+  unsigned _modelEpoch;
+
+  struct DeactivationRecord
+  {
+    Clause* clause;
+    unsigned epoch;
+  };
+  /**
+   * Passive clauses left in place on deactivation of their components,
+   * in the order of deactivation. A record is stale if the clause was
+   * deactivated again since, see @b _deactivatedSince.
+   */
+  Deque<DeactivationRecord> _deactivated;
+  /** the model epoch in which a lazily deactivated clause was last deactivated */
+  DHMap<Clause*,unsigned> _deactivatedSince;
+
   SaturationAlgorithm* _sa;
 
   // clauses we already added to the SAT solver
@@ -31,7 +31,22 @@ using namespace Lib;
 Lexer::Lexer (istream& in)
   : _charBuffer(512),
     _charCursor(0),
-    _stream(in),
+    _stream(&in),
+    _mem(nullptr),
+    _memEnd(nullptr),
+    _eof(false),
+    _lineNumber(1),
+    _lookAheadChar(0)
+{
+  readNextChar();
+} // Lexer::Lexer
+
+Lexer::Lexer (const char* begin, const char* end)
+  : _charBuffer(512),
+    _charCursor(0),
+    _stream(nullptr),
+    _mem(begin),
+    _memEnd(end),
     _eof(false),
     _lineNumber(1),
     _lookAheadChar(0)
@@ -62,7 +77,7 @@ bool Lexer::readNextChar ()
     return false;
   }
 
-  _lastCharacter = _stream.get();
+  _lastCharacter = getFromInput();
   if (_lastCharacter == -1) {
     _eof = true;
     return false;
@@ -206,7 +221,7 @@ int Lexer::lookAhead()
 {
   ASS(! _lookAheadChar); // cannot look ahead by two characters!
 
-  _lookAheadChar = _stream.get();
+  _lookAheadChar = getFromInput();
   return _lookAheadChar;
 } // Lexer::lookAhead()
 
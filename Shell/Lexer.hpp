@@ -55,6 +55,8 @@ class Lexer
 {
 public:
   Lexer(std::istream& in);
+  /** Read the characters in [begin,end), which must stay in place while the lexer exists */
+  Lexer(const char* begin, const char* end);
   /** True if the lexer is at the end of file */
   bool isAtEndOfFile () const { return _eof; }
   /** Return the last character */
@@ -72,8 +74,12 @@ protected:
   Array<char> _charBuffer;
   /** cursor to the current character */
   int _charCursor;
-  /** the input stream */
-  std::istream& _stream;
+  /** the input stream, null when reading from memory */
+  std::istream* _stream;
+  /** when reading from memory, the next character */
+  const char* _mem;
+  /** when reading from memory, the position beyond the last character */
+  const char* _memEnd;
   /** true if end-of-file is reached */
   bool _eof;
   /** current line number, counting from 1 */
@@ -81,6 +87,9 @@ protected:
   /** lookahead character. In this implementation there may be only one */
   int _lookAheadChar;
 
+  /** Get the next character of the input or -1 at its end, as istream::get() */
+  int getFromInput()
+  { return _stream ? _stream->get() : (_mem < _memEnd ? (unsigned char)*_mem++ : -1); }
   bool readNextChar();
   void readNumber(Token&);
   void readUnsignedInteger();
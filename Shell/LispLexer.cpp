@@ -34,6 +34,11 @@ LispLexer::LispLexer (istream& in)
 {
 } // LispLexer::LispLexer
 
+LispLexer::LispLexer (const char* begin, const char* end)
+  : Lexer (begin,end)
+{
+} // LispLexer::LispLexer
+
 
 /**
  * Skip all whitespaces and comments. After this operation either
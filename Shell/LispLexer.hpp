@@ -32,6 +32,7 @@ class LispLexer
 {
 public:
   LispLexer(std::istream& in);
+  LispLexer(const char* begin, const char* end);
   void readToken (Token&);
   ~LispLexer () {}
 
@@ -150,10 +150,54 @@ void LispParser::parse(EList** expr0)
   parsing_level_done:
     ASS(stack.isNonEmpty());
     expr = stack.pop();
+    if (stack.isEmpty()) {
+      // only when called from parseNext(): the list at expr0 is closed
+      return;
+    }
   }
 
 } // parse()
 
+LispParser::Expression* LispParser::parseNext()
+{
+  Token t;
+  _lexer.readToken(t);
+  switch (t.tag) {
+  case TT_EOF:
+    return nullptr;
+  case TT_RPAR:
+    throw Exception("unmatched right parenthesis",t);
+  case TT_LPAR:
+    {
+      _balance++;
+      Expression* result = new Expression(LIST);
+      parse(&result->list);
+      ASS_EQ(_balance,0);
+      return result;
+    }
+  case TT_NAME:
+  case TT_INTEGER:
+  case TT_REAL:
+    return new Expression(ATOM,t.text);
+  default:
+    ASSERTION_VIOLATION;
+    return nullptr;
+  }
+} // parseNext()
+
+void LispParser::Expression::destroy()
+{
+  Stack<Expression*> toDelete;
+  toDelete.push(this);
+  while (toDelete.isNonEmpty()) {
+    Expression* e = toDelete.pop();
+    while (e->list) {
+      toDelete.push(EList::pop(e->list));
+    }
+    delete e;
+  }
+} // Expression::destroy
+
 /**
  * Return a LISP string corresponding to this expression
  * @since 26/08/2009 Redmond
@@ -69,6 +69,8 @@ public:
 	list(0)
     {}
     std::string toString(bool outerParentheses=true) const;
+    /** Delete the expression with all its subexpressions */
+    void destroy();
 
     bool isList() const { return tag==LIST; }
     bool isAtom() const { return tag==ATOM; }
@@ -84,6 +86,11 @@ public:
   explicit LispParser(LispLexer& lexer);
   Expression* parse();
   void parse(EList**);
+  /**
+   * Read only the next top-level expression, return nullptr at the end of the input.
+   * This allows processing and destroying each top-level expression before the next one is read.
+   */
+  Expression* parseNext();
 
   /**
    * Class Exception. Implements parser exceptions.
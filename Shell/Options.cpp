@@ -344,6 +344,26 @@ void Options::init()
   _lookup.insert(&_statistics);
   _statistics.tag(OptionTag::OUTPUT);
 
+  _statisticsSnapshotFile = StringOptionValue("statistics_snapshot_file", "ssf", "");
+  _statisticsSnapshotFile.description = "During saturation, append a line with a snapshot of the statistics"
+    " (clause container and index sizes, generated and deleted clauses, memory, LRS limits, ...) to this file."
+    " It can also be a FIFO or a unix domain socket, then snapshots are dropped while nobody reads them.";
+  _lookup.insert(&_statisticsSnapshotFile);
+  _statisticsSnapshotFile.tag(OptionTag::OUTPUT);
+
+  _statisticsSnapshotActivations = UnsignedOptionValue("statistics_snapshot_activations", "ssa", 0);
+  _statisticsSnapshotActivations.description = "Write a statistics snapshot every this many activations (0 means never).";
+  _lookup.insert(&_statisticsSnapshotActivations);
+  _statisticsSnapshotActivations.tag(OptionTag::OUTPUT);
+  _statisticsSnapshotActivations.onlyUsefulWith(_statisticsSnapshotFile.is(notEqual(std::string(""))));
+
+  _statisticsSnapshotPeriod = UnsignedOptionValue("statistics_snapshot_period", "ssp", 1000);
+  _statisticsSnapshotPeriod.description = "Write a statistics snapshot every this many milliseconds (0 means never)."
+    " The period is only checked between activations, so during a long activation snapshots are written less often.";
+  _lookup.insert(&_statisticsSnapshotPeriod);
+  _statisticsSnapshotPeriod.tag(OptionTag::OUTPUT);
+  _statisticsSnapshotPeriod.onlyUsefulWith(_statisticsSnapshotFile.is(notEqual(std::string(""))));
+
   _testId = StringOptionValue("test_id", "", "unspecified_test"); // Used by spider mode
   _testId.description = "";
   _lookup.insert(&_testId);
@@ -381,6 +401,39 @@ void Options::init()
   _timeStatistics.description = "Show how much running time was spent in each part of Vampire";
   _lookup.insert(&_timeStatistics);
   _timeStatistics.tag(OptionTag::OUTPUT);
+
+  _timeStatisticsFile = StringOptionValue("time_statistics_file", "tstat_file", "");
+  _timeStatisticsFile.description = "Also write the time statistics to this file, in the format given by time_statistics_format."
+    " In portfolio mode the file contains the statistics of all the slices run.";
+  _lookup.insert(&_timeStatisticsFile);
+  _timeStatisticsFile.tag(OptionTag::OUTPUT);
+  _timeStatisticsFile.onlyUsefulWith(_timeStatistics.is(equal(true)));
+
+  _timeStatisticsFormat = ChoiceOptionValue<TimeStatisticsFormat>("time_statistics_format", "tstat_format",
+      TimeStatisticsFormat::JSON, {"json", "chrome"});
+  _timeStatisticsFormat.description = "Format of the time_statistics_file:\n"
+    " - json writes the tree of measured blocks as nested objects\n"
+    " - chrome writes trace events that chrome://tracing or Perfetto show as a flame graph";
+  _lookup.insert(&_timeStatisticsFormat);
+  _timeStatisticsFormat.tag(OptionTag::OUTPUT);
+  _timeStatisticsFormat.onlyUsefulWith(_timeStatistics.is(equal(true)));
+
+  _timeStatisticsSampling = UnsignedOptionValue("time_statistics_sampling", "tstat_sampling", 0);
+  _timeStatisticsSampling.description = "If not 0, do not read the clock when entering and leaving the measured blocks,"
+    " but estimate their time by looking which block is running every this many microseconds of CPU time."
+    " The estimates are less precise, but the blocks cost less to measure.";
+  _lookup.insert(&_timeStatisticsSampling);
+  _timeStatisticsSampling.tag(OptionTag::OUTPUT);
+  _timeStatisticsSampling.onlyUsefulWith(_timeStatistics.is(equal(true)));
+
+#if VAMPIRE_PERF_EXISTS
+  _timeStatisticsCounters = BoolOptionValue("time_statistics_counters", "tstat_counters", false);
+  _timeStatisticsCounters.description = "Also count retired instructions, cycles, cache misses and branch mispredictions"
+    " of each measured block, using perf events. Not together with time_statistics_sampling.";
+  _lookup.insert(&_timeStatisticsCounters);
+  _timeStatisticsCounters.tag(OptionTag::OUTPUT);
+  _timeStatisticsCounters.onlyUsefulWith(_timeStatistics.is(equal(true)));
+#endif
 #endif // VTIME_PROFILING
 
   //*********************** Input  ***********************
@@ -797,6 +850,28 @@ void Options::init()
               _saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
   };
 
+  _termSharingGC = UnsignedOptionValue("term_sharing_gc", "tsgc", 0);
+  _termSharingGC.description =
+      "If non-zero, shared terms and literals created during saturation are garbage collected "
+      "once there are more than this many thousands of them. Terms that made it into an index are kept. "
+      "Only used for first-order problems without theories.";
+  _lookup.insert(&_termSharingGC);
+  _termSharingGC.setExperimental();
+  _termSharingGC.tag(OptionTag::SATURATION);
+  _termSharingGC.onlyUsefulWith(ProperSaturationAlgorithm());
+  // these keep terms outside of clauses and indices
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_induction.is(equal(Induction::NONE))));
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_instantiation.is(equal(Instantiation::OFF))));
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_globalSubsumption.is(equal(false))));
+#if VZ3
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_theoryInstAndSimp.is(equal(TheoryInstSimp::OFF))));
+#endif
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_termAlgebraCyclicityCheck.is(equal(TACyclicityCheck::OFF))));
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_conditionalRedundancyCheck.is(equal(false))));
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_demodulationPrecompiledComparison.is(equal(false))));
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_questionAnswering.is(equal(QuestionAnsweringMode::OFF))));
+  _termSharingGC.addHardConstraint(If(notEqual(0u)).then(_proofExtra.is(notEqual(ProofExtra::FULL))));
+
   _sos = ChoiceOptionValue<Sos>("sos", "sos", Sos::OFF, {"all", "off", "on", "theory"});
   _sos.description =
       "Set of support strategy. All formulas annotated as axioms are put directly among active clauses, without performing any inferences between them."
@@ -905,6 +980,33 @@ void Options::init()
   _fmbKeepSbeamGenerators.onlyUsefulWith(_fmbEnumerationStrategy.is(equal(FMBEnumerationStrategy::SBMEAM)));
   _fmbKeepSbeamGenerators.tag(OptionTag::FMB);
 
+  _fmbLazyInstances = BoolOptionValue("fmb_lazy_instances", "fmbli", false);
+  _fmbLazyInstances.description = "Only add the instances of non-ground clauses which are false in the model found by the SAT solver, and solve again, until there are none. "
+    "Trades repeated SAT solver calls for a much smaller encoding.";
+  _lookup.insert(&_fmbLazyInstances);
+  _fmbLazyInstances.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::FINITE_MODEL_BUILDING)));
+  _fmbLazyInstances.setExperimental();
+  _fmbLazyInstances.tag(OptionTag::FMB);
+
+  _fmbIncremental = BoolOptionValue("fmb_incremental", "fmbinc", false);
+  _fmbIncremental.description = "Keep the SAT solver, with its learned clauses, when the domain sizes grow and only add the clauses mentioning the new domain elements. "
+    "The clauses specific to the sizes, i.e. totality and symmetry breaking, are guarded by selectors.";
+  _lookup.insert(&_fmbIncremental);
+  _fmbIncremental.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::FINITE_MODEL_BUILDING)));
+  _fmbIncremental.onlyUsefulWith(_fmbEnumerationStrategy.is(notEqual(FMBEnumerationStrategy::CONTOUR)));
+  _fmbIncremental.setExperimental();
+  _fmbIncremental.tag(OptionTag::FMB);
+
+  _fmbWorkers = UnsignedOptionValue("fmb_workers", "fmbw", 1);
+  _fmbWorkers.description = "Number of domain size assignments explored concurrently, each in a forked worker process sharing the memory limit. "
+    "Sizes ruled out by one worker are not tried by the others and all the workers stop once a model is found. (Not supported by the contour enumeration strategy.)";
+  _lookup.insert(&_fmbWorkers);
+  _fmbWorkers.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::FINITE_MODEL_BUILDING)));
+  _fmbWorkers.onlyUsefulWith(_fmbEnumerationStrategy.is(notEqual(FMBEnumerationStrategy::CONTOUR)));
+  _fmbWorkers.addHardConstraint(greaterThan(0u));
+  _fmbWorkers.setExperimental();
+  _fmbWorkers.tag(OptionTag::FMB);
+
   _selection = SelectionOptionValue("selection", "s", 10);
   _selection.description =
       "Selection methods 2,3,4,10,11 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011 relax this restriction and are therefore not complete.\n"
@@ -1592,6 +1694,14 @@ void Options::init()
   _demodulationPrecompiledComparison.onlyUsefulWith(Or(_forwardDemodulation.is(notEqual(Demodulation::OFF)), _backwardDemodulation.is(notEqual(Demodulation::OFF))));
   _demodulationPrecompiledComparison.addProblemConstraint(hasEquality());
 
+  _demodulationComparatorCache = UnsignedOptionValue("demodulation_comparator_cache", "dcc", 0);
+  _demodulationComparatorCache.description =
+      "Number of precompiled comparators of removed demodulators that are kept for reuse when an equal demodulator is added again (e.g. after AVATAR backtracking).";
+  _lookup.insert(&_demodulationComparatorCache);
+  _demodulationComparatorCache.setExperimental();
+  _demodulationComparatorCache.tag(OptionTag::INFERENCES);
+  _demodulationComparatorCache.onlyUsefulWith(_demodulationPrecompiledComparison.is(equal(true)));
+
   _demodulationOnlyEquational = BoolOptionValue("demodulation_only_equational", "doe", false);
   _demodulationOnlyEquational.description =
       "Disables demodulation of non-equational literals. In combination with -ins > 0 simulates the effect of Waldmeister's `Enlarging the Hypothesis` trick.";
@@ -2075,6 +2185,19 @@ void Options::init()
   // if minimize is sco then we could have a conflict clause added infinitely often
   _splittingEagerRemoval.onlyUsefulWith(_splittingMinimizeModel.is(equal(SplittingMinimizeModel::ALL)));
 
+  _splittingIncrementalModel = BoolOptionValue("avatar_incremental_model", "aim", false);
+  _splittingIncrementalModel.description = "Update the selected components (and the ground literals for congruence closure) only for"
+                                           " the SAT variables whose value may have changed since the last model, instead of going through all of them."
+                                           " Congruence closure then backtracks to retract the literals no longer true instead of starting from scratch."
+                                           " Needs a SAT solver that tracks the changes (cdcl) and no model minimization.";
+  _lookup.insert(&_splittingIncrementalModel);
+  _splittingIncrementalModel.setExperimental();
+  _splittingIncrementalModel.tag(OptionTag::AVATAR);
+  _splittingIncrementalModel.onlyUsefulWith(_splitting.is(equal(true)));
+  _splittingIncrementalModel.onlyUsefulWith(_satSolver.is(equal(SatSolver::CDCL)));
+  _splittingIncrementalModel.onlyUsefulWith(_splittingMinimizeModel.is(equal(SplittingMinimizeModel::OFF)));
+  _splittingIncrementalModel.onlyUsefulWith(_splittingBufferedSolver.is(equal(false)));
+
   _splittingFastRestart = BoolOptionValue("avatar_fast_restart", "afr", false);
   _splittingFastRestart.description = "";
   _lookup.insert(&_splittingFastRestart);
@@ -2095,6 +2218,16 @@ void Options::init()
   _splittingDeleteDeactivated.tag(OptionTag::AVATAR);
   _splittingDeleteDeactivated.onlyUsefulWith(_splitting.is(equal(true)));
 
+  _splittingLazyDeactivation = UnsignedOptionValue("avatar_lazy_deactivation", "ald", 0);
+  _splittingLazyDeactivation.description =
+      "If non-zero, passive clauses depending on a deactivated component are not removed from passive right away."
+      " They are skipped by index retrieval and clause selection while their components are inactive"
+      " and only removed once they stayed inactive for the given number of model changes.";
+  _lookup.insert(&_splittingLazyDeactivation);
+  _splittingLazyDeactivation.setExperimental();
+  _splittingLazyDeactivation.tag(OptionTag::AVATAR);
+  _splittingLazyDeactivation.onlyUsefulWith(_splitting.is(equal(true)));
+
   _splittingFlushPeriod = UnsignedOptionValue("avatar_flush_period", "afp", 0);
   _splittingFlushPeriod.description =
       "after given number of generated clauses without deriving an empty clause, the splitting component selection is shuffled. If equal to zero, shuffling is never performed.";
@@ -2141,19 +2274,21 @@ void Options::init()
   // _nonliteralsInClauseWeight.addProblemConstraint(mayHaveNonUnits()); (for the same reason this is disabled in splitting)
 
   //*********************** SAT solver (used in various places)  ***********************
-  _satSolver = ChoiceOptionValue<SatSolver>("sat_solver", "sas", SatSolver::MINISAT, {"minisat"
+  _satSolver = ChoiceOptionValue<SatSolver>("sat_solver", "sas", SatSolver::MINISAT, {"minisat", "cdcl"
 #if VZ3
                                                                                       ,
                                                                                       "z3"
 #endif
                                                                                      });
   _satSolver.description = "Select the SAT solver to be used throughout the solver."
-                           " This will be used in AVATAR (for splitting) when the saturation algorithm is discount, lrs or otter.";
+                           " This will be used in AVATAR (for splitting) when the saturation algorithm is discount, lrs or otter"
+                           " and, if cdcl is selected, also in global subsumption."
+                           " cdcl is Vampire's own incremental solver, which simplifies and vivifies its clauses between calls.";
   _lookup.insert(&_satSolver);
-  // in principle, global subsumption also depends on the SAT solver choice, however,
-  // 1) currently, it doesn't actually support Z3
+  // global subsumption also depends on the SAT solver choice, however,
+  // 1) currently, it doesn't actually support Z3 (and falls back to minisat)
   // 2) there is no reason why only one sat solver should be driving all three, so more than on _satSolver-like option should be considered in the future
-  _satSolver.onlyUsefulWith(_splitting.is(equal(true)));
+  _satSolver.onlyUsefulWith(Or(_splitting.is(equal(true)),_globalSubsumption.is(equal(true))));
   _satSolver.tag(OptionTag::SAT);
 
 #if VZ3
@@ -2166,6 +2301,12 @@ void Options::init()
   _satFallbackForSMT.onlyUsefulWith(_satSolver.is(equal(SatSolver::Z3)));
 #endif
 
+  _satTrace = StringOptionValue("sat_trace", "", "");
+  _satTrace.description = "Record the calls to the SAT solvers of AVATAR, global subsumption and finite model building"
+                          " into binary files <sat_trace>.<user>.<pid>.<n>.trace, which can be replayed (and timed) with satreplay.";
+  _lookup.insert(&_satTrace);
+  _satTrace.tag(OptionTag::DEVELOPMENT);
+
   //*************************************************************
   //*********************** which mode or tag?  ************************
   //*************************************************************
@@ -2308,6 +2449,14 @@ void Options::init()
   _kboAdmissabilityCheck.tag(OptionTag::SATURATION);
   _lookup.insert(&_kboAdmissabilityCheck);
 
+  _kboComparisonCache = UnsignedOptionValue("kbo_comparison_cache", "kcc", 0);
+  _kboComparisonCache.description = "Cache the results of KBO comparisons of shared terms in a direct-mapped table with 2^n entries. 0 disables the cache, at most 24 is allowed.";
+  _kboComparisonCache.addHardConstraint(lessThan(25u));
+  _kboComparisonCache.setExperimental();
+  _kboComparisonCache.onlyUsefulWith(_termOrdering.is(equal(TermOrdering::KBO)));
+  _kboComparisonCache.tag(OptionTag::SATURATION);
+  _lookup.insert(&_kboComparisonCache);
+
   _functionWeights = StringOptionValue("function_weights", "fw", "");
   _functionWeights.description =
       "Path to a file that defines weights for KBO for function symbols.\n"
@@ -297,6 +297,13 @@ public:
     CHEAP
   };
 
+  enum class TimeStatisticsFormat : unsigned int {
+    /** the tree of TIME_TRACE scopes as nested JSON objects */
+    JSON,
+    /** the Chrome trace-event format, for chrome://tracing or Perfetto */
+    CHROME
+  };
+
   enum class ProofExtra : unsigned int {
     OFF,
     FREE,
@@ -469,10 +476,11 @@ public:
 
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
-    MINISAT = 0
+    MINISAT = 0,
+    CDCL = 1
 #if VZ3
     ,
-    Z3 = 1
+    Z3 = 2
 #endif
   };
 
@@ -2077,6 +2085,9 @@ public:
   std::string testId() const { return _testId.actualValue; }
   std::string protectedPrefix() const { return _protectedPrefix.actualValue; }
   Statistics statistics() const { return _statistics.actualValue; }
+  const std::string& statisticsSnapshotFile() const { return _statisticsSnapshotFile.actualValue; }
+  unsigned statisticsSnapshotActivations() const { return _statisticsSnapshotActivations.actualValue; }
+  unsigned statisticsSnapshotPeriod() const { return _statisticsSnapshotPeriod.actualValue; }
   void setStatistics(Statistics newVal) { _statistics.actualValue = newVal; }
   Proof proof() const { return _proof.actualValue; }
   bool minimizeSatProofs() const { return _minimizeSatProofs.actualValue; }
@@ -2097,6 +2108,9 @@ public:
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
   bool keepSbeamGenerators() const { return _fmbKeepSbeamGenerators.actualValue; }
+  bool fmbLazyInstances() const { return _fmbLazyInstances.actualValue; }
+  bool fmbIncremental() const { return _fmbIncremental.actualValue; }
+  unsigned fmbWorkers() const { return _fmbWorkers.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   Mode mode() const { return _mode.actualValue; }
@@ -2190,6 +2204,7 @@ public:
   unsigned distinctGroupExpansionLimit() const { return _distinctGroupExpansionLimit.actualValue; }
   void setUnusedPredicateDefinitionRemoval(bool newVal) { _unusedPredicateDefinitionRemoval.actualValue = newVal; }
   SatSolver satSolver() const { return _satSolver.actualValue; }
+  std::string const& satTrace() const { return _satTrace.actualValue; }
   // void setSatSolver(SatSolver newVal) { _satSolver = newVal; }
   SaturationAlgorithm saturationAlgorithm() const { return _saturationAlgorithm.actualValue; }
   void setSaturationAlgorithm(SaturationAlgorithm newVal) { _saturationAlgorithm.actualValue = newVal; }
@@ -2218,6 +2233,7 @@ public:
   Demodulation backwardDemodulation() const { return _backwardDemodulation.actualValue; }
   DemodulationRedundancyCheck demodulationRedundancyCheck() const { return _demodulationRedundancyCheck.actualValue; }
   bool demodulationPrecompiledComparison() const { return _demodulationPrecompiledComparison.actualValue; }
+  unsigned demodulationComparatorCache() const { return _demodulationComparatorCache.actualValue; }
   bool demodulationOnlyEquational() const { return _demodulationOnlyEquational.actualValue; }
 
   // void setBackwardDemodulation(Demodulation newVal) { _backwardDemodulation = newVal; }
@@ -2241,6 +2257,7 @@ public:
   KboWeightGenerationScheme kboWeightGenerationScheme() const { return _kboWeightGenerationScheme.actualValue; }
   bool kboMaxZero() const { return _kboMaxZero.actualValue; }
   const KboAdmissibilityCheck kboAdmissabilityCheck() const { return _kboAdmissabilityCheck.actualValue; }
+  unsigned kboComparisonCache() const { return _kboComparisonCache.actualValue; }
   const std::string &functionWeights() const { return _functionWeights.actualValue; }
   const std::string &predicateWeights() const { return _predicateWeights.actualValue; }
   const std::string &functionPrecedence() const { return _functionPrecedence.actualValue; }
@@ -2299,6 +2316,7 @@ public:
   unsigned nongoalWeightCoefficientDenominator() const { return _nonGoalWeightCoefficient.denominator; }
   bool restrictNWCtoGC() const { return _restrictNWCtoGC.actualValue; }
   Sos sos() const { return _sos.actualValue; }
+  unsigned termSharingGC() const { return _termSharingGC.actualValue; }
   unsigned sosTheoryLimit() const { return _sosTheoryLimit.actualValue; }
   // void setSos(Sos newVal) { _sos = newVal; }
 
@@ -2340,6 +2358,12 @@ public:
   bool generalSplitting() const { return _generalSplitting.actualValue; }
 #if VTIME_PROFILING
   bool timeStatistics() const { return _timeStatistics.actualValue; }
+  const std::string& timeStatisticsFile() const { return _timeStatisticsFile.actualValue; }
+  TimeStatisticsFormat timeStatisticsFormat() const { return _timeStatisticsFormat.actualValue; }
+  unsigned timeStatisticsSampling() const { return _timeStatisticsSampling.actualValue; }
+#if VAMPIRE_PERF_EXISTS
+  bool timeStatisticsCounters() const { return _timeStatisticsCounters.actualValue; }
+#endif
 #endif // VTIME_PROFILING
   bool splitting() const { return _splitting.actualValue; }
   void setSplitting(bool value) { _splitting.actualValue = value; }
@@ -2390,7 +2414,9 @@ public:
   SplittingMinimizeModel splittingMinimizeModel() const { return _splittingMinimizeModel.actualValue; }
   SplittingLiteralPolarityAdvice splittingLiteralPolarityAdvice() const { return _splittingLiteralPolarityAdvice.actualValue; }
   SplittingDeleteDeactivated splittingDeleteDeactivated() const { return _splittingDeleteDeactivated.actualValue; }
+  unsigned splittingLazyDeactivation() const { return _splittingLazyDeactivation.actualValue; }
   bool splittingFastRestart() const { return _splittingFastRestart.actualValue; }
+  bool splittingIncrementalModel() const { return _splittingIncrementalModel.actualValue; }
   bool splittingBufferedSolver() const { return _splittingBufferedSolver.actualValue; }
   int splittingFlushPeriod() const { return _splittingFlushPeriod.actualValue; }
   float splittingFlushQuotient() const { return _splittingFlushQuotient.actualValue; }
@@ -2596,6 +2622,7 @@ private:
 
   ChoiceOptionValue<DemodulationRedundancyCheck> _demodulationRedundancyCheck;
   BoolOptionValue _demodulationPrecompiledComparison;
+  UnsignedOptionValue _demodulationComparatorCache;
   BoolOptionValue _demodulationOnlyEquational;
 
   ChoiceOptionValue<EqualityProxy> _equalityProxy;
@@ -2623,6 +2650,9 @@ private:
   UnsignedOptionValue _fmbSizeWeightRatio;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
   BoolOptionValue _fmbKeepSbeamGenerators;
+  BoolOptionValue _fmbLazyInstances;
+  BoolOptionValue _fmbIncremental;
+  UnsignedOptionValue _fmbWorkers;
 
   BoolOptionValue _flattenTopLevelConjunctions;
   StringOptionValue _forbiddenOptions;
@@ -2747,6 +2777,7 @@ private:
   IntOptionValue _activationLimit;
 
   ChoiceOptionValue<SatSolver> _satSolver;
+  StringOptionValue _satTrace;
   ChoiceOptionValue<SaturationAlgorithm> _saturationAlgorithm;
   BoolOptionValue _showAll;
   BoolOptionValue _showFluted;
@@ -2804,6 +2835,7 @@ private:
   FloatOptionValue _sineTolerance;
   FloatOptionValue _sineToAgeTolerance;
   ChoiceOptionValue<Sos> _sos;
+  UnsignedOptionValue _termSharingGC;
   UnsignedOptionValue _sosTheoryLimit;
   BoolOptionValue _splitting;
   BoolOptionValue _splitAtActivation;
@@ -2818,10 +2850,15 @@ private:
   ChoiceOptionValue<SplittingMinimizeModel> _splittingMinimizeModel;
   ChoiceOptionValue<SplittingLiteralPolarityAdvice> _splittingLiteralPolarityAdvice;
   ChoiceOptionValue<SplittingDeleteDeactivated> _splittingDeleteDeactivated;
+  UnsignedOptionValue _splittingLazyDeactivation;
   BoolOptionValue _splittingFastRestart;
+  BoolOptionValue _splittingIncrementalModel;
   BoolOptionValue _splittingBufferedSolver;
 
   ChoiceOptionValue<Statistics> _statistics;
+  StringOptionValue _statisticsSnapshotFile;
+  UnsignedOptionValue _statisticsSnapshotActivations;
+  UnsignedOptionValue _statisticsSnapshotPeriod;
   BoolOptionValue _superpositionFromVariables;
   ChoiceOptionValue<TermOrdering> _termOrdering;
   ChoiceOptionValue<SymbolPrecedence> _symbolPrecedence;
@@ -2831,6 +2868,7 @@ private:
   ChoiceOptionValue<KboWeightGenerationScheme> _kboWeightGenerationScheme;
   BoolOptionValue _kboMaxZero;
   ChoiceOptionValue<KboAdmissibilityCheck> _kboAdmissabilityCheck;
+  UnsignedOptionValue _kboComparisonCache;
   StringOptionValue _functionWeights;
   StringOptionValue _predicateWeights;
   StringOptionValue _typeConPrecedence;
@@ -2848,6 +2886,10 @@ private:
   /** Time limit in deciseconds */
   TimeLimitOptionValue _timeLimitInDeciseconds;
   BoolOptionValue _timeStatistics;
+  StringOptionValue _timeStatisticsFile;
+  ChoiceOptionValue<TimeStatisticsFormat> _timeStatisticsFormat;
+  UnsignedOptionValue _timeStatisticsSampling;
+  BoolOptionValue _timeStatisticsCounters;
 
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
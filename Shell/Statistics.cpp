@@ -156,8 +156,18 @@ Statistics::Statistics()
     passiveClauses(0),
     activeClauses(0),
     extensionalityClauses(0),
+    deletedClauses(0),
     discardedNonRedundantClauses(0),
     inferencesBlockedForOrderingAftercheck(0),
+    termCollections(0),
+    collectedTerms(0),
+    kboCacheGroundHits(0),
+    kboCacheNonGroundHits(0),
+    kboCacheMisses(0),
+    orderingComparatorsCreated(0),
+    orderingComparatorsReused(0),
+    orderingComparatorsEvicted(0),
+    orderingComparatorCacheMaxSize(0),
     smtReturnedUnknown(false),
     smtDidNotEvaluate(false),
     inferencesSkippedDueToColors(0),
@@ -173,10 +183,14 @@ Statistics::Statistics()
 
     satSplits(0),
     satSplitRefutations(0),
+    lazilyDeactivatedClauses(0),
+    lazilyReactivatedClauses(0),
+    lazilyEvictedClauses(0),
 
     smtFallbacks(0),
 
     satPureVarsEliminated(0),
+    fmbSizeAttemptCount(0),
     terminationReason(UNKNOWN),
     refutation(0),
     saturatedSet(0),
@@ -283,7 +297,8 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck+
+      termCollections);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Activations started", activations);
@@ -297,6 +312,19 @@ void Statistics::print(ostream& out)
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Term garbage collections", termCollections);
+  COND_OUT("Collected terms", collectedTerms);
+  SEPARATOR;
+
+  HEADING("Term Ordering",kboCacheGroundHits+kboCacheNonGroundHits+kboCacheMisses+
+      orderingComparatorsCreated+orderingComparatorsReused);
+  COND_OUT("KBO cache hits (ground)", kboCacheGroundHits);
+  COND_OUT("KBO cache hits (non-ground)", kboCacheNonGroundHits);
+  COND_OUT("KBO cache misses", kboCacheMisses);
+  COND_OUT("Ordering comparators created", orderingComparatorsCreated);
+  COND_OUT("Ordering comparators reused", orderingComparatorsReused);
+  COND_OUT("Ordering comparators evicted", orderingComparatorsEvicted);
+  COND_OUT("Ordering comparator cache max size", orderingComparatorCacheMaxSize);
   SEPARATOR;
 
 
@@ -447,10 +475,28 @@ void Statistics::print(ostream& out)
   COND_OUT("Unique components", uniqueComponents);
   //COND_OUT("Sat splits", satSplits); // same as split clauses
   COND_OUT("Sat splitting refutations", satSplitRefutations);
+  COND_OUT("Lazily deactivated clauses", lazilyDeactivatedClauses);
+  COND_OUT("Lazily reactivated clauses", lazilyReactivatedClauses);
+  COND_OUT("Lazily evicted clauses", lazilyEvictedClauses);
   COND_OUT("SMT fallbacks",smtFallbacks);
   SEPARATOR;
 
-  //TODO record statistics for FMB
+  HEADING("Finite Model Building",fmbSizeAttemptCount);
+  for (const FmbSizeAttempt& a : fmbSizeAttempts) {
+    addCommentSignForSZS(out);
+    out << "Sizes [";
+    for (unsigned i = 0; i < a.sizes.size(); i++) {
+      out << (i ? "," : "") << a.sizes[i];
+    }
+    out << "]: " << a.clauses << " clauses, "
+        << a.encodingMs << " ms encoding, " << a.solvingMs << " ms solving" << endl;
+    separable = true;
+  }
+  if (fmbSizeAttemptCount > fmbSizeAttempts.size()) {
+    addCommentSignForSZS(out);
+    out << "(" << fmbSizeAttemptCount - fmbSizeAttempts.size() << " more sizes tried)" << endl;
+  }
+  SEPARATOR;
 
   //TODO record statistics for MiniSAT
   HEADING("SAT Solver Statistics",satClauses+unitSatClauses+binarySatClauses+satPureVarsEliminated);
@@ -489,6 +535,7 @@ void Statistics::print(ostream& out)
 #if VTIME_PROFILING
   if (env.options && env.options->timeStatistics()) {
     TimeTrace::instance().printPretty(out);
+    TimeTrace::instance().exportToFile();
   }
 #endif // VTIME_PROFILING
 }
@@ -21,6 +21,8 @@
 
 #include "Forwards.hpp"
 #include "Debug/Assertion.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
 
 extern const char *VERSION_STRING;
 
@@ -244,10 +246,32 @@ public:
   unsigned activeClauses;
   /** all extensionality clauses */
   unsigned extensionalityClauses;
+  /** clauses simplified away without a replacement, e.g. tautologies and subsumed clauses */
+  unsigned deletedClauses;
 
   unsigned discardedNonRedundantClauses;
 
   unsigned inferencesBlockedForOrderingAftercheck;
+  /** garbage collections of shared terms */
+  unsigned termCollections;
+  /** shared terms and literals freed by them */
+  unsigned collectedTerms;
+
+  // Term ordering
+  /** KBO comparisons of ground terms answered by the comparison cache */
+  unsigned kboCacheGroundHits;
+  /** KBO comparisons of non-ground terms answered by the comparison cache */
+  unsigned kboCacheNonGroundHits;
+  /** cacheable KBO comparisons that had to be computed */
+  unsigned kboCacheMisses;
+  /** ordering comparators compiled for demodulators */
+  unsigned orderingComparatorsCreated;
+  /** demodulators that got an already compiled ordering comparator */
+  unsigned orderingComparatorsReused;
+  /** unused ordering comparators evicted from the cache */
+  unsigned orderingComparatorsEvicted;
+  /** maximal number of ordering comparators in the cache */
+  unsigned orderingComparatorCacheMaxSize;
 
   bool smtReturnedUnknown;
   bool smtDidNotEvaluate;
@@ -274,12 +298,33 @@ public:
 
   unsigned satSplits;
   unsigned satSplitRefutations;
+  /** clauses of deactivated components left in passive by lazy deactivation */
+  unsigned lazilyDeactivatedClauses;
+  /** lazily deactivated clauses that became active again while still in passive */
+  unsigned lazilyReactivatedClauses;
+  /** lazily deactivated clauses evicted from passive after staying inactive */
+  unsigned lazilyEvictedClauses;
 
   unsigned smtFallbacks;
 
   /** Number of pure variables eliminated by SAT solver */
   unsigned satPureVarsEliminated;
 
+  /** a size assignment tried by the finite model builder */
+  struct FmbSizeAttempt {
+    /** the sizes of the distinct sorts */
+    Lib::DArray<unsigned> sizes;
+    /** clauses passed to the SAT solver for these sizes */
+    unsigned clauses;
+    unsigned encodingMs;
+    unsigned solvingMs;
+  };
+  /** only the first this many size assignments tried are kept in fmbSizeAttempts */
+  static constexpr unsigned FMB_SIZE_ATTEMPTS_KEPT = 100;
+  Lib::Stack<FmbSizeAttempt> fmbSizeAttempts;
+  /** the number of size assignments tried */
+  unsigned fmbSizeAttemptCount;
+
   /** termination reason */
   enum TerminationReason {
     /** refutation found */
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file StatisticsSnapshot.cpp
+ * Implements class StatisticsSnapshot.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Lib/Timer.hpp"
+
+#include "StatisticsSnapshot.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+
+StatisticsSnapshot::StatisticsSnapshot(std::string path, unsigned activationPeriod, unsigned msPeriod)
+  : _path(std::move(path)), _activationPeriod(activationPeriod), _msPeriod(msPeriod),
+    _lastActivations(0), _lastMs(Timer::elapsedMilliseconds()), _fd(-1), _socket(false)
+{
+  struct stat st;
+  if (stat(_path.c_str(), &st) == 0 && (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode))) {
+    // a reader going away must not kill us
+    signal(SIGPIPE, SIG_IGN);
+  }
+}
+
+StatisticsSnapshot::~StatisticsSnapshot()
+{
+  disconnect();
+}
+
+/**
+ * Return true if a snapshot should be written now, after @b activations
+ * activations, and if so, start the next period
+ */
+bool StatisticsSnapshot::due(unsigned activations)
+{
+  bool res = _activationPeriod && activations >= _lastActivations + _activationPeriod;
+  if (!res && _msPeriod) {
+    res = Timer::elapsedMilliseconds() >= _lastMs + _msPeriod;
+  }
+  if (res) {
+    _lastActivations = activations;
+    _lastMs = Timer::elapsedMilliseconds();
+  }
+  return res;
+}
+
+/** Open the destination, return false if that is not possible now */
+bool StatisticsSnapshot::connect()
+{
+  if (_fd != -1) {
+    return true;
+  }
+  struct stat st;
+  _socket = stat(_path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode);
+  if (_socket) {
+    sockaddr_un addr;
+    if (_path.size() >= sizeof(addr.sun_path)) {
+      return false;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, _path.c_str());
+    _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_fd != -1 && ::connect(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      disconnect();
+    }
+  } else {
+    // non-blocking: opening a FIFO without a reader fails rather than waits
+    _fd = open(_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_NONBLOCK, 0644);
+  }
+  return _fd != -1;
+}
+
+void StatisticsSnapshot::disconnect()
+{
+  if (_fd != -1) {
+    close(_fd);
+    _fd = -1;
+  }
+}
+
+/** Write @b line followed by a newline, drop it if nobody is reading */
+void StatisticsSnapshot::write(const std::string& line)
+{
+  if (!connect()) {
+    return;
+  }
+  std::string data = line + "\n";
+  ssize_t written = _socket
+    ? send(_fd, data.c_str(), data.size(), MSG_DONTWAIT)
+    : ::write(_fd, data.c_str(), data.size());
+  if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+    // e.g. the reader went away, try again next time
+    disconnect();
+  }
+}
+
+unsigned long StatisticsSnapshot::memoryInUse()
+{
+  // the resident set size, where it is available
+  std::ifstream statm("/proc/self/statm");
+  unsigned long size, resident;
+  if (statm >> size >> resident) {
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+  }
+  // otherwise the maximum so far
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+  return 0;
+}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file StatisticsSnapshot.hpp
+ * Defines class StatisticsSnapshot, for watching the progress of long runs.
+ */
+
+#ifndef __StatisticsSnapshot__
+#define __StatisticsSnapshot__
+
+#include <string>
+
+#include "Lib/Allocator.hpp"
+
+namespace Shell {
+
+/**
+ * Decides when a snapshot of the statistics is due and writes it, as a line,
+ * to a regular file, a FIFO or a unix domain socket.
+ *
+ * Lines are appended to regular files, so that the slices of a portfolio run
+ * can share one. A FIFO or socket without a reader does not stop the proof
+ * search, the snapshots are dropped until a reader appears.
+ */
+class StatisticsSnapshot
+{
+public:
+  USE_ALLOCATOR(StatisticsSnapshot);
+
+  StatisticsSnapshot(std::string path, unsigned activationPeriod, unsigned msPeriod);
+  ~StatisticsSnapshot();
+
+  bool due(unsigned activations);
+  void write(const std::string& line);
+
+  /** Memory used by the process in kilobytes, or 0 if unknown */
+  static unsigned long memoryInUse();
+
+private:
+  bool connect();
+  void disconnect();
+
+  std::string _path;
+  /** a snapshot every this many activations, 0 for never */
+  unsigned _activationPeriod;
+  /** a snapshot every this many milliseconds, 0 for never */
+  unsigned _msPeriod;
+  unsigned _lastActivations;
+  long _lastMs;
+  /** file descriptor to write to, -1 if not connected */
+  int _fd;
+  bool _socket;
+};
+
+}
+
+#endif // __StatisticsSnapshot__
@@ -57,6 +57,8 @@ using namespace Kernel;
 using namespace Saturation;
 using namespace std;
 
+using Lib::Sys::MappedFile;
+
 bool outputAllowed(bool debug)
 {
 #if VDEBUG
@@ -199,26 +201,32 @@ static bool hasEnding (std::string const &fullString, std::string const &ending)
   }
 }
 
-void UIHelper::tryParseTPTP(istream& input)
+void UIHelper::tryParseTPTP(istream& input, const MappedFile* mapped)
 {
   LoadedPiece& curPiece = _loadedPieces.top();
-  Parse::TPTP parser(input,curPiece._units);
+  ScopedPtr<Parse::TPTP> parser(mapped ?
+      new Parse::TPTP(mapped->begin(),mapped->end(),curPiece._units) :
+      new Parse::TPTP(input,curPiece._units));
   try {
-    parser.parse();
-    curPiece._units = parser.unitBuffer();
-    curPiece._hasConjecture |= parser.containsConjecture();
+    parser->parse();
+    curPiece._units = parser->unitBuffer();
+    curPiece._hasConjecture |= parser->containsConjecture();
   } catch (ParsingRelatedException& exception) {
     UnitList::destroy(curPiece._units.clipAtLast()); // destroy units that perhaps got already parsed
     throw;
   }
 }
 
-void UIHelper::tryParseSMTLIB2(istream& input)
+void UIHelper::tryParseSMTLIB2(istream& input, const MappedFile* mapped)
 {
   LoadedPiece& curPiece = _loadedPieces.top();
   Parse::SMTLIB2 parser(curPiece._units);
   try {
-    parser.parse(input);
+    if (mapped) {
+      parser.parse(mapped->begin(),mapped->end());
+    } else {
+      parser.parse(input);
+    }
     Unit::onParsingEnd(); // dubious in interactiveMetamode (influences SMT goal guessing and InferenceStore::ProofPropertyPrinter)
     curPiece._units = parser.formulaBuffer();
     curPiece._smtLibLogic = parser.getLogic();
@@ -249,10 +257,10 @@ void UIHelper::parseSingleLine(const std::string& lineToParse, Options::InputSyn
   try {
     switch (inputSyntax) {
       case Options::InputSyntax::TPTP:
-        tryParseTPTP(stream);
+        tryParseTPTP(stream,nullptr);
         break;
       case Options::InputSyntax::SMTLIB2:
-        tryParseSMTLIB2(stream);
+        tryParseSMTLIB2(stream,nullptr);
         break;
       case Options::InputSyntax::AUTO:
         ASSERTION_VIOLATION;
@@ -280,7 +288,8 @@ void resetParsing(ParsingRelatedException& exception, istream& input, std::strin
   input.seekg(0);
 }
 
-void UIHelper::parseStream(std::istream& input, Options::InputSyntax inputSyntax, bool verbose, bool preferSMTonAuto)
+void UIHelper::parseStream(std::istream& input, Options::InputSyntax inputSyntax, bool verbose, bool preferSMTonAuto,
+                           const MappedFile* mapped)
 {
   switch (inputSyntax) {
   case Options::InputSyntax::AUTO:
@@ -290,10 +299,10 @@ void UIHelper::parseStream(std::istream& input, Options::InputSyntax inputSyntax
         std::cout << "Running in auto input_syntax mode. Trying SMTLIB2\n";
       }
       try {
-        tryParseSMTLIB2(input);
+        tryParseSMTLIB2(input,mapped);
       } catch (ParsingRelatedException& exception) {
         resetParsing(exception,input,"TPTP");
-        tryParseTPTP(input);
+        tryParseTPTP(input,mapped);
       }
     } else {
       if (verbose) {
@@ -301,18 +310,18 @@ void UIHelper::parseStream(std::istream& input, Options::InputSyntax inputSyntax
         std::cout << "Running in auto input_syntax mode. Trying TPTP\n";
       }
       try {
-        tryParseTPTP(input);
+        tryParseTPTP(input,mapped);
       } catch (ParsingRelatedException& exception) {
         resetParsing(exception,input,"SMTLIB2");
-        tryParseSMTLIB2(input);
+        tryParseSMTLIB2(input,mapped);
       }
     }
     break;
   case Options::InputSyntax::TPTP:
-    tryParseTPTP(input);
+    tryParseTPTP(input,mapped);
     break;
   case Options::InputSyntax::SMTLIB2:
-    tryParseSMTLIB2(input);
+    tryParseSMTLIB2(input,mapped);
     break;
   }
 }
@@ -350,9 +359,12 @@ void UIHelper::parseFile(const std::string& inputFile, Options::InputSyntax inpu
   if (input.fail()) {
     USER_ERROR("Cannot open problem file: "+inputFile);
   }
+  // the lexers can work on the mapped file without copying it through the stream
+  MappedFile mapped(inputFile);
 
   try {
-    parseStream(input,inputSyntax,verbose,hasEnding(inputFile,"smt") || hasEnding(inputFile,"smt2"));
+    parseStream(input,inputSyntax,verbose,hasEnding(inputFile,"smt") || hasEnding(inputFile,"smt2"),
+                mapped.isOpen() ? &mapped : nullptr);
   } catch (ParsingRelatedException& exception) {
     _loadedPieces.pop();
     throw;
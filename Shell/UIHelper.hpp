@@ -21,6 +21,7 @@
 #include "Options.hpp"
 
 #include "Lib/Stack.hpp"
+#include "Lib/Sys/MappedFile.hpp"
 
 namespace Shell {
 
@@ -45,12 +46,14 @@ private:
   };
   static Stack<LoadedPiece> _loadedPieces;
 
-  static void tryParseTPTP(std::istream& input);
-  static void tryParseSMTLIB2(std::istream& input);
+  static void tryParseTPTP(std::istream& input, const Lib::Sys::MappedFile* mapped);
+  static void tryParseSMTLIB2(std::istream& input, const Lib::Sys::MappedFile* mapped);
 public:
   static void parseSingleLine(const std::string& lineToParse, Options::InputSyntax inputSyntax);
 
-  static void parseStream(std::istream& input, Options::InputSyntax inputSyntax, bool verbose, bool preferSMTonAuto);
+  /** If @b mapped is given, it has the same content as @b input and is lexed directly */
+  static void parseStream(std::istream& input, Options::InputSyntax inputSyntax, bool verbose, bool preferSMTonAuto,
+                          const Lib::Sys::MappedFile* mapped = nullptr);
   static void parseStandardInput(Options::InputSyntax inputSyntax);
   static void parseFile(const std::string& inputFile, Options::InputSyntax inputSyntax, bool verbose);
 
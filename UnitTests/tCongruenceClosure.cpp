@@ -0,0 +1,97 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#include "DP/SimpleCongruenceClosure.hpp"
+
+using namespace DP;
+
+#define MY_SYNTAX_SUGAR                                                                                       \
+  DECL_SORT(s)                                                                                                \
+  DECL_CONST(a, s)                                                                                            \
+  DECL_CONST(b, s)                                                                                            \
+  DECL_CONST(c, s)                                                                                            \
+  DECL_FUNC(f, {s}, s)                                                                                        \
+  DECL_PRED(p, {s})                                                                                           \
+
+static void pushLiteral(SimpleCongruenceClosure& cc, Literal* lit)
+{
+  cc.push();
+  cc.addLiteral(lit);
+}
+
+static bool coreIs(SimpleCongruenceClosure& cc, std::initializer_list<Literal*> expected)
+{
+  LiteralStack core;
+  cc.getUnsatCore(core, 0);
+  if (core.size() != expected.size()) {
+    return false;
+  }
+  for (Literal* l : expected) {
+    if (!core.find(l)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST_FUN(popRetractsLiterals) {
+  MY_SYNTAX_SUGAR
+  SimpleCongruenceClosure cc(nullptr);
+
+  pushLiteral(cc, a == b);
+  pushLiteral(cc, f(a) != f(b));
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  ASS(coreIs(cc, { a == b, f(a) != f(b) }));
+
+  cc.pop();
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::SATISFIABLE);
+
+  cc.pop();
+  pushLiteral(cc, f(a) != f(b));
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::SATISFIABLE);
+}
+
+TEST_FUN(termsIntroducedAbovePoppedLevel) {
+  MY_SYNTAX_SUGAR
+  SimpleCongruenceClosure cc(nullptr);
+
+  pushLiteral(cc, a == b);
+  // f(a) and f(b) are first seen here and must be congruent also after the pop
+  pushLiteral(cc, f(a) == c);
+  pushLiteral(cc, f(b) == c);
+  cc.pop(2);
+
+  pushLiteral(cc, f(b) != f(a));
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  ASS(coreIs(cc, { a == b, f(b) != f(a) }));
+}
+
+TEST_FUN(predicatesAcrossLevels) {
+  MY_SYNTAX_SUGAR
+  SimpleCongruenceClosure cc(nullptr);
+
+  pushLiteral(cc, p(a));
+  pushLiteral(cc, c == a);
+  pushLiteral(cc, b == c);
+  pushLiteral(cc, ~p(b));
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  ASS(coreIs(cc, { p(a), c == a, b == c, ~p(b) }));
+
+  cc.pop(3);
+  pushLiteral(cc, ~p(b));
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::SATISFIABLE);
+
+  pushLiteral(cc, a == b);
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  ASS(coreIs(cc, { p(a), ~p(b), a == b }));
+}
@@ -16,6 +16,7 @@
 #include "SAT/SATLiteral.hpp"
 #include "SAT/SATInference.hpp"
 #include "SAT/SATSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
@@ -132,6 +133,9 @@ TEST_FUN(testProofWithAssums)
 {
   MinisatInterfacing s(*env.options,true);
   testProofWithAssumptions(s);
+
+  CDCLSolver sCDCL(*env.options,true);
+  testProofWithAssumptions(sCDCL);
 }
 
 void testInterface(SATSolverWithAssumptions &s) {
@@ -224,6 +228,10 @@ TEST_FUN(testSATSolverInterface)
   MinisatInterfacing sMini(*env.options,true);
   testInterface(sMini);
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testInterface(sCDCL);
+
   /* Not fully conforming - does not support zeroImplied and resource-limited solving
   cout << endl << "Z3" << endl;
   {
@@ -282,6 +290,10 @@ TEST_FUN(testSolvingUnderAssumptions)
   MinisatInterfacing sMini(*env.options,true);
   testAssumptions(sMini);
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testAssumptions(sCDCL);
+
   /*cout << endl << "Z3" << endl;
   {
     SAT2FO sat2fo;
@@ -289,3 +301,39 @@ TEST_FUN(testSolvingUnderAssumptions)
     testAssumptions(sZ3);
   }*/
 }
+
+TEST_FUN(testCDCLChangedVars)
+{
+  CDCLSolver sCDCL(*env.options,true);
+  SATSolver& s = sCDCL;
+  SATClause* cl = getClause("AB");
+  unsigned varCnt = 0;
+  for (unsigned i = 0; i < cl->size(); i++) {
+    varCnt = std::max(varCnt, (*cl)[i].var());
+  }
+  s.ensureVarCount(varCnt);
+  s.addClause(cl);
+  ASS_EQ(s.solve(),SATSolver::Status::SATISFIABLE);
+
+  // at first, every variable has a new value
+  Stack<unsigned> changed;
+  ASS(s.collectChangedVars(changed));
+  ASS_EQ(changed.size(),varCnt);
+
+  changed.reset();
+  ASS(s.collectChangedVars(changed));
+  ASS(changed.isEmpty());
+
+  // force a and b to the opposite of what they are now
+  bool aTrue = s.trueInAssignment(getLit('A'));
+  bool bTrue = s.trueInAssignment(getLit('B'));
+  s.addClause(getClause(aTrue ? "a" : "A"));
+  s.addClause(getClause(bTrue ? "b" : "B"));
+  ASS_EQ(s.solve(),SATSolver::Status::SATISFIABLE);
+
+  ASS(s.collectChangedVars(changed));
+  ASS(changed.find(getLit('a').var()));
+  ASS(changed.find(getLit('b').var()));
+  ASS_NEQ(s.trueInAssignment(getLit('A')),aTrue);
+  ASS_NEQ(s.trueInAssignment(getLit('B')),bTrue);
+}
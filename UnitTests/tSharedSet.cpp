@@ -0,0 +1,76 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Debug/Assertion.hpp"
+#include "Lib/SharedSet.hpp"
+#include "Test/UnitTesting.hpp"
+
+using namespace Lib;
+
+using USet = SharedSet<unsigned>;
+
+static const USet* set(std::initializer_list<unsigned> items)
+{
+  Stack<unsigned> st(items);
+  return USet::getFromArray(st.begin(), st.size());
+}
+
+TEST_FUN(sharing)
+{
+  ASS_EQ(set({ 3, 1, 2 }), set({ 1, 2, 3 }));
+  ASS_EQ(set({ 1, 1, 64 }), set({ 64, 1 }));
+  ASS_EQ(set({}), USet::getEmpty());
+}
+
+TEST_FUN(member)
+{
+  auto s = set({ 0, 5, 63, 64, 200 });
+  ASS(s->member(0));
+  ASS(s->member(64));
+  ASS(s->member(200));
+  // same signature bits as members
+  NEVER(s->member(128));
+  NEVER(s->member(127));
+  NEVER(s->member(6));
+}
+
+TEST_FUN(union_)
+{
+  auto s1 = set({ 1, 65, 100 });
+  auto s2 = set({ 2, 65 });
+  auto u = set({ 1, 2, 65, 100 });
+  ASS_EQ(s1->getUnion(s2), u);
+  // remembered results
+  ASS_EQ(s1->getUnion(s2), u);
+  ASS_EQ(s2->getUnion(s1), u);
+  ASS_EQ(u->getUnion(s1), u);
+  ASS_EQ(s1->getUnion(u), u);
+  ASS_EQ(s1->getUnion(USet::getEmpty()), s1);
+}
+
+TEST_FUN(subtract_intersect)
+{
+  auto s1 = set({ 1, 65, 100 });
+  auto s2 = set({ 129, 3 });
+  ASS_EQ(s1->subtract(s2), s1);
+  ASS_EQ(s1->subtract(set({ 65 })), set({ 1, 100 }));
+  ASS_EQ(s1->getIntersection(s2), USet::getEmpty());
+  ASS_EQ(s1->getIntersection(set({ 100, 101 })), set({ 100 }));
+  NEVER(s1->hasIntersection(s2));
+  ASS(s1->hasIntersection(set({ 2, 65 })));
+}
+
+TEST_FUN(subset)
+{
+  auto s = set({ 1, 65, 100 });
+  ASS(set({ 1, 100 })->isSubsetOf(s));
+  ASS(USet::getEmpty()->isSubsetOf(s));
+  NEVER(set({ 1, 129 })->isSubsetOf(s));
+  NEVER(set({ 1, 2 })->isSubsetOf(s));
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Debug/Assertion.hpp"
+#include "Lib/Hash.hpp"
+#include "Lib/SharingTable.hpp"
+#include "Test/UnitTesting.hpp"
+#include "UnitTests/dummyHash.hpp"
+
+using namespace Lib;
+
+/** only a few distinct hashes, so that there are many equal control bytes and full hashes */
+class FewHashes {
+public:
+  static bool equals(unsigned v1, unsigned v2) { return v1 == v2; }
+  static unsigned hash(unsigned v) { return (v % 5) * 0x1001; }
+};
+
+template<class Hash>
+static bool insert(SharingTable<unsigned,Hash>& table, unsigned v)
+{
+  bool inserted;
+  ALWAYS(table.rawFindOrInsert([&]() { return v; }, Hash::hash(v), [&](unsigned w) { return w == v; }, inserted) == v);
+  return inserted;
+}
+
+template<class Hash>
+static void insertFindRemove(unsigned cnt)
+{
+  SharingTable<unsigned,Hash> table;
+  for (unsigned i = 0; i < cnt; i++) {
+    ALWAYS(insert(table, i));
+  }
+  ASS_EQ(table.size(), cnt);
+  for (unsigned i = 0; i < cnt; i++) {
+    NEVER(insert(table, i));
+  }
+  ASS_EQ(table.size(), cnt);
+
+  // remove the even ones
+  for (unsigned i = 0; i < cnt; i += 2) {
+    ALWAYS(table.remove(i));
+  }
+  NEVER(table.remove(0));
+  ASS_EQ(table.size(), cnt / 2);
+  for (unsigned i = 0; i < cnt; i++) {
+    unsigned res;
+    if (i % 2) {
+      ALWAYS(table.find(i, res));
+    } else {
+      NEVER(table.find(i, res));
+    }
+  }
+
+  // inserting again reuses the deleted slots
+  for (unsigned i = 0; i < cnt; i += 2) {
+    ALWAYS(insert(table, i));
+  }
+  ASS_EQ(table.size(), cnt);
+  for (unsigned i = 0; i < cnt; i++) {
+    unsigned res = cnt;
+    ALWAYS(table.find(i, res));
+    ASS_EQ(res, i);
+  }
+}
+
+TEST_FUN(growing)
+{
+  insertFindRemove<DefaultHash>(10000);
+}
+
+TEST_FUN(equal_control_bytes)
+{
+  insertFindRemove<FewHashes>(200);
+}
+
+TEST_FUN(single_hash)
+{
+  insertFindRemove<DummyHash>(100);
+}
+
+TEST_FUN(many_removals)
+{
+  // the table must not fill up with deleted slots
+  SharingTable<unsigned,DefaultHash> table;
+  for (unsigned i = 0; i < 100000; i++) {
+    ALWAYS(insert(table, i));
+    ALWAYS(table.remove(i));
+  }
+  ASS_EQ(table.size(), 0u);
+  ALWAYS(insert(table, 7));
+  ASS_EQ(table.size(), 1u);
+}
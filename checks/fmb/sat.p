@@ -0,0 +1,4 @@
+% satisfiable, the smallest model has two elements
+fof(a,axiom, p(a)).
+fof(b,axiom, ~p(b)).
+fof(c,axiom, ![X]: (p(X) | q(f(X)))).
@@ -0,0 +1,3 @@
+% checks that a problem and its includes are read from disk
+include('parse/include.ax').
+fof(goal,conjecture, ?[X]: q(s(X),"c d")).
@@ -927,6 +927,10 @@ int main(int argc, char *argv[])
 
 #if VTIME_PROFILING
     TimeTrace::instance().setEnabled(opts.timeStatistics());
+    TimeTrace::instance().setSampling(opts.timeStatisticsSampling());
+#if VAMPIRE_PERF_EXISTS
+    TimeTrace::instance().setCounting(opts.timeStatisticsCounters());
+#endif
 #endif
 
     // If any of these options are set then we just need to output and exit